@@ -0,0 +1,245 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "parallel_sort.h"
+#include "parallel_prefix_sum.h"
+
+namespace embree
+{
+  /*! hash function of the parallel hash containers (MurmurHash3 finalizer) */
+  __forceinline uint32_t parallel_hash(uint32_t h)
+  {
+    h ^= h >> 16; h *= 0x85ebca6b;
+    h ^= h >> 13; h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+  }
+
+  __forceinline uint32_t parallel_hash(uint64_t h)
+  {
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return (uint32_t) h;
+  }
+
+  /*! Open addressing hash table of 32 or 64 bit keys with linear
+   *  probing. Keys are placed in the order of their hash slots, thus
+   *  the position of each key is a prefix maximum that can get
+   *  calculated in parallel without any atomic operations. */
+  template<typename Key>
+  class parallel_hash_table
+  {
+    static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "unsupported key type");
+
+    /* number of keys compared per SIMD probe */
+    static const size_t W = 16/sizeof(Key);
+
+    /* hash slot and index of some key to build the table */
+    struct SlotIndex
+    {
+      __forceinline SlotIndex () {}
+
+      __forceinline SlotIndex (const uint32_t slot, const uint32_t index)
+        : slot(slot), index(index) {}
+
+      __forceinline operator uint32_t() const {
+        return slot;
+      }
+
+    public:
+      uint32_t slot;
+      uint32_t index;
+    };
+
+    /* offset of the hash slot to the sorted position of some key */
+    struct SlotOffset
+    {
+      __forceinline SlotOffset (const std::vector<SlotIndex>& order)
+        : order(order) {}
+
+      __forceinline ssize_t operator[] (const size_t i) const {
+        return ssize_t(order[i].slot)-ssize_t(i);
+      }
+
+      const std::vector<SlotIndex>& order;
+    };
+
+  public:
+
+    /*! returned by find if some key is not contained in the table */
+    static const size_t invalid = size_t(-1);
+
+    /*! marks empty slots, such keys are stored in an extra slot */
+    static __forceinline Key empty() {
+      return Key(-1);
+    }
+
+  public:
+
+    parallel_hash_table () { clear(); }
+
+    /*! Initializes the table from a vector of keys. Calls allocate(n)
+     *  once with the number of slots to store values for, before
+     *  assign(slot,i) is called for the slot of each key in[i]. */
+    template<typename KeyVector, typename Allocate, typename Assign>
+      void init(const KeyVector& in, const Allocate& allocate, const Assign& assign)
+    {
+      const size_t N = in.size();
+      assert(N < 0x7FFFFFFF);
+      size_t capacity = 16;
+      while (capacity < 2*N) capacity *= 2;
+      mask = capacity-1;
+
+      /* sort keys by their hash slot, empty keys are moved to the end */
+      std::vector<SlotIndex> order(N);
+      parallel_for( size_t(0), N, size_t(4*4096), [&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          const Key key = (Key) in[i];
+          const uint32_t slot = key == empty() ? 0xFFFFFFFF : parallel_hash(key) & uint32_t(mask);
+          order[i] = SlotIndex(slot,(uint32_t)i);
+        }
+      });
+      std::vector<SlotIndex> temp(N);
+      radix_sort<SlotIndex,uint32_t>(order.data(),temp.data(),N);
+
+      size_t M = N;
+      while (M > 0 && order[M-1].slot == 0xFFFFFFFF) M--;
+
+      /* each key gets placed at max(slot[i],position[i-1]+1), which is
+       * i plus the maximum of slot[j]-j over all j<=i */
+      std::vector<ssize_t> offset(M);
+      parallel_prefix_sum(SlotOffset(order),offset,M,std::numeric_limits<ssize_t>::min(),[](ssize_t a, ssize_t b) { return max(a,b); });
+      auto position = [&] (const size_t i) -> size_t {
+        return max(offset[i],ssize_t(order[i].slot)-ssize_t(i)) + i;
+      };
+
+      /* the padding guarantees an empty slot at the end of each cluster for the SIMD probes */
+      const size_t numSlots = max(capacity, M ? position(M-1)+1 : 0) + W;
+      keys.resize(numSlots);
+      parallel_for( size_t(0), numSlots, size_t(4*4096), [&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++)
+          keys[i] = empty();
+      });
+      allocate(numSlots+1);
+
+      parallel_for( size_t(0), M, size_t(4*4096), [&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          const size_t slot = position(i);
+          keys[slot] = (Key) in[order[i].index];
+          assign(slot,order[i].index);
+        }
+      });
+
+      /* the empty key is stored in an extra slot after all others */
+      emptySlot = invalid;
+      for (size_t i=M; i<N; i++) {
+        emptySlot = numSlots;
+        assign(numSlots,order[i].index);
+      }
+    }
+
+    /*! returns the slot of the specified key, or invalid if the key is not contained in the table */
+    __forceinline size_t find(const Key& key) const
+    {
+      if (unlikely(key == empty()))
+        return emptySlot;
+
+      const vint4 k = splat(key);
+      const vint4 e = splat(empty());
+      for (size_t slot = parallel_hash(key) & mask;; slot += W)
+      {
+        const vint4 v = vint4::loadu(&keys[slot]);
+        const size_t hit  = lanes(movemask(v == k));
+        const size_t stop = lanes(movemask(v == e));
+        if (hit | stop) {
+          const size_t i = bsf(hit | stop);
+          return (hit >> i) & 1 ? slot + i*W/4 : invalid;
+        }
+      }
+    }
+
+    /*! clears all state */
+    void clear()
+    {
+      mask = 0;
+      emptySlot = invalid;
+      std::vector<Key>(W,empty()).swap(keys);
+    }
+
+  private:
+
+    /* replicates the key into all W lanes of a SIMD register */
+    static __forceinline vint4 splat(const Key key)
+    {
+      Key k[W];
+      for (size_t i=0; i<W; i++) k[i] = key;
+      return vint4::loadu(k);
+    }
+
+    /* converts the mask of 32 bit lanes into a mask of keys, each 64 bit key requires two matching lanes */
+    static __forceinline size_t lanes(const size_t m) {
+      return sizeof(Key) == 4 ? m : m & (m >> 1) & 0x5;
+    }
+
+  private:
+    std::vector<Key> keys;   //!< keys of each slot
+    size_t mask;             //!< number of hash slots minus one
+    size_t emptySlot;        //!< slot of the empty key if contained
+  };
+
+  template<typename Key>
+    const size_t parallel_hash_table<Key>::invalid;
+
+  /*! implementation of a key/value hash map with parallel construction */
+  template<typename Key, typename Val>
+  class parallel_hash_map
+  {
+  public:
+
+    /*! parallel hash map constructors */
+    parallel_hash_map () {}
+
+    /*! construction from pair of vectors */
+    template<typename KeyVector, typename ValVector>
+      parallel_hash_map (const KeyVector& keys, const ValVector& values) { init(keys,values); }
+
+    /*! initialized the parallel hash map from a vector with keys and values */
+    template<typename KeyVector, typename ValVector>
+      void init(const KeyVector& keys, const ValVector& values)
+    {
+      assert(keys.size() == values.size());
+      table.init(keys,
+                 [&] (size_t numSlots) { vals.resize(numSlots); },
+                 [&] (size_t slot, size_t i) { vals[slot] = values[i]; });
+    }
+
+    /*! Returns a pointer to the value associated with the specified key. The pointer will be nullptr of the key is not contained in the map. */
+    __forceinline const Val* lookup(const Key& key) const
+    {
+      const size_t slot = table.find(key);
+      if (slot == table.invalid) return nullptr;
+      return &vals[slot];
+    }
+
+    /*! If the key is in the map, the function returns the value associated with the key, otherwise it returns the default value. */
+    __forceinline Val lookup(const Key& key, const Val& def) const
+    {
+      const size_t slot = table.find(key);
+      if (slot == table.invalid) return def;
+      return vals[slot];
+    }
+
+    /*! clears all state */
+    void clear() {
+      table.clear();
+      vals.clear();
+    }
+
+  private:
+    parallel_hash_table<Key> table;  //!< hash table of all keys
+    std::vector<Val> vals;           //!< value of each slot of the table
+  };
+}
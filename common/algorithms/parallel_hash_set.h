@@ -0,0 +1,45 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "parallel_hash_map.h"
+
+namespace embree
+{
+  /* implementation of a hash set of values with parallel construction */
+  template<typename T>
+  class parallel_hash_set
+  {
+  public:
+
+    /*! default constructor for the parallel hash set */
+    parallel_hash_set () {}
+
+    /*! construction from vector */
+    template<typename Vector>
+      parallel_hash_set (const Vector& in) { init(in); }
+
+    /*! initialized the parallel hash set from a vector */
+    template<typename Vector>
+      void init(const Vector& in)
+    {
+      table.init(in,
+                 [] (size_t numSlots) {},
+                 [] (size_t slot, size_t i) {});
+    }
+
+    /*! tests if some element is in the set */
+    __forceinline bool lookup(const T& elt) const {
+      return table.find(elt) != table.invalid;
+    }
+
+    /*! clears all state */
+    void clear() {
+      table.clear();
+    }
+
+  private:
+    parallel_hash_table<T> table;   //!< hash table of all elements
+  };
+}
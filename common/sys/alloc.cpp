@@ -233,6 +233,13 @@ namespace embree
   void os_advise(void *ptr, size_t bytes)
   {
   }
+
+  void* os_malloc_file(size_t bytes, const std::string& dir)
+  {
+    /* file mappings cannot get released with VirtualFree, thus use anonymous memory */
+    bool hugepages = false;
+    return os_malloc(bytes,hugepages);
+  }
 }
 
 #endif
@@ -244,6 +251,7 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -372,6 +380,28 @@ namespace embree
     madvise(pptr,bytes,MADV_HUGEPAGE); 
 #endif
   }
+
+  void* os_malloc_file(size_t bytes, const std::string& dir)
+  {
+    if (bytes == 0)
+      return nullptr;
+
+    /* the file gets deleted right away, its pages stay accessible through the mapping */
+    std::string name = dir + "/embree.XXXXXX";
+    int fd = mkstemp(&name[0]);
+    if (fd == -1) throw std::bad_alloc();
+    unlink(name.c_str());
+
+    if (ftruncate(fd,bytes) == -1) {
+      close(fd);
+      throw std::bad_alloc();
+    }
+
+    void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) throw std::bad_alloc();
+    return ptr;
+  }
 }
 
 #endif
@@ -84,6 +84,9 @@ namespace embree
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
 
+  /*! maps pages of a deleted temporary file in the directory, free using os_free */
+  void* os_malloc_file (size_t bytes, const std::string& dir);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
@@ -506,6 +506,29 @@ namespace embree
     return nThreads;
   }
 
+  unsigned int getNumberOfNUMANodes()
+  {
+    static int nNodes = -1;
+    if (nNodes != -1) return nNodes;
+
+    ULONG highestNode = 0;
+    if (GetNumaHighestNodeNumber(&highestNode)) nNodes = highestNode+1;
+    else                                        nNodes = 1;
+    return nNodes;
+  }
+
+  unsigned int getCurrentNUMANode()
+  {
+    const unsigned int nNodes = getNumberOfNUMANodes();
+    if (nNodes <= 1) return 0;
+
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT node = 0;
+    if (!GetNumaProcessorNodeEx(&processor,&node)) return 0;
+    return node < nNodes ? (unsigned int) node : 0;
+  }
+
   int getTerminalWidth() 
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -524,6 +547,16 @@ namespace embree
     return (double)val.QuadPart / (double)freq.QuadPart;
   }
 
+  double getProcessCPUSeconds()
+  {
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+      return 0.0;
+    const uint64_t kernel = (uint64_t(kernelTime.dwHighDateTime) << 32) | uint64_t(kernelTime.dwLowDateTime);
+    const uint64_t user   = (uint64_t(userTime.dwHighDateTime) << 32) | uint64_t(userTime.dwLowDateTime);
+    return 1E-7*double(kernel+user);
+  }
+
   void sleepSeconds(double t) {
     Sleep(DWORD(1000.0*t));
   }
@@ -552,9 +585,79 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
 
 namespace embree
 {
+  /* parses a list of the form 0-3,8,10-11 as used by sysfs */
+  static bool parseSysfsList(const std::string& fileName, std::vector<size_t>& list)
+  {
+    std::ifstream fs(fileName.c_str());
+    if (fs.fail()) return false;
+
+    size_t begin = 0;
+    while (fs >> begin)
+    {
+      size_t end = begin;
+      if (fs.peek() == '-') {
+        fs.ignore();
+        if (!(fs >> end)) return false;
+      }
+      for (size_t i=begin; i<=end; i++)
+        list.push_back(i);
+      if (fs.peek() == ',')
+        fs.ignore();
+    }
+    return !list.empty();
+  }
+
+  /* NUMA topology as reported by the kernel, the nodes are numbered consecutively */
+  struct NUMATopology
+  {
+    NUMATopology ()
+      : numNodes(1)
+    {
+      std::vector<size_t> nodes;
+      if (!parseSysfsList("/sys/devices/system/node/online",nodes))
+        return;
+
+      for (size_t i=0; i<nodes.size(); i++)
+      {
+        std::vector<size_t> cpus;
+        parseSysfsList("/sys/devices/system/node/node" + toString(nodes[i]) + "/cpulist",cpus);
+        for (size_t cpu : cpus) {
+          if (cpu >= cpuToNode.size()) cpuToNode.resize(cpu+1,0);
+          cpuToNode[cpu] = (unsigned int) i;
+        }
+      }
+      numNodes = (unsigned int) nodes.size();
+    }
+
+  public:
+    unsigned int numNodes;               //!< number of online NUMA nodes
+    std::vector<unsigned int> cpuToNode; //!< NUMA node of each logical CPU
+  };
+
+  static const NUMATopology& getNUMATopology()
+  {
+    static NUMATopology topology;
+    return topology;
+  }
+
+  unsigned int getNumberOfNUMANodes() {
+    return getNUMATopology().numNodes;
+  }
+
+  unsigned int getCurrentNUMANode()
+  {
+    const NUMATopology& topology = getNUMATopology();
+    if (topology.numNodes <= 1) return 0;
+
+    const int cpu = sched_getcpu();
+    if (cpu < 0 || size_t(cpu) >= topology.cpuToNode.size()) return 0;
+    return topology.cpuToNode[cpu];
+  }
+
   std::string getExecutableFileName() 
   {
     std::string pid = "/proc/" + toString(getpid()) + "/exe";
@@ -655,6 +758,7 @@ namespace embree
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <sys/time.h>
+#include <sys/resource.h>
 #include <pthread.h>
 
 #if defined(__EMSCRIPTEN__)
@@ -709,12 +813,38 @@ namespace embree
     return double(tp.tv_sec) + double(tp.tv_usec)/1E6;
   }
 
+  double getProcessCPUSeconds()
+  {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF,&usage) != 0) return 0.0;
+    return double(usage.ru_utime.tv_sec) + double(usage.ru_utime.tv_usec)/1E6
+         + double(usage.ru_stime.tv_sec) + double(usage.ru_stime.tv_usec)/1E6;
+  }
+
   void sleepSeconds(double t) {
     usleep(1000000.0*t);
   }
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Platforms without NUMA topology detection
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(__WIN32__) && !defined(__LINUX__)
+
+namespace embree
+{
+  unsigned int getNumberOfNUMANodes() {
+    return 1;
+  }
+
+  unsigned int getCurrentNUMANode() {
+    return 0;
+  }
+}
+#endif
+
 #if defined(__INTEL_LLVM_COMPILER)
 #pragma clang diagnostic pop
 #endif
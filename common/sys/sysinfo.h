@@ -170,12 +170,21 @@ namespace embree
   /*! return the number of logical threads of the system */
   unsigned int getNumberOfLogicalThreads();
 
+  /*! return the number of NUMA nodes of the system, 1 if the topology is unknown */
+  unsigned int getNumberOfNUMANodes();
+
+  /*! returns the NUMA node (0..getNumberOfNUMANodes()-1) of the CPU the calling thread runs on */
+  unsigned int getCurrentNUMANode();
+
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
 
   /*! returns performance counter in seconds */
   double getSeconds();
 
+  /*! returns CPU time consumed by all threads of the process in seconds */
+  double getProcessCPUSeconds();
+
   /*! sleeps the specified number of seconds */
   void sleepSeconds(double t);
 
@@ -34,6 +34,10 @@ namespace embree
           }
         }
         yield();
+
+        /* the thread may have migrated to a different NUMA node while yielding */
+        if (threadPool->numaAware())
+          thread.numaNode.store(currentNUMANode(),std::memory_order_relaxed);
       }
     }
   }
@@ -72,23 +76,60 @@ namespace embree
     run_internal(thread);
   }
 
+  dll_export TaskScheduler::TaskQueue::TaskQueue ()
+    : left(0), right(0), stackPtr(0)
+  {
+    for (size_t i=0; i<MAX_TASK_SEGMENTS; i++)
+      segments[i].store(nullptr);
+    for (size_t i=0; i<MAX_CLOSURE_BLOCKS; i++)
+      blocks[i] = nullptr;
+
+    allocSegment(0);
+    allocBlock(0);
+  }
+
+  dll_export TaskScheduler::TaskQueue::~TaskQueue ()
+  {
+    for (size_t i=0; i<MAX_TASK_SEGMENTS; i++)
+      alignedFree(segments[i].load());
+    for (size_t i=0; i<MAX_CLOSURE_BLOCKS; i++)
+      alignedFree(blocks[i]);
+  }
+
+  dll_export void TaskScheduler::TaskQueue::allocSegment(size_t i)
+  {
+    if (i >= MAX_TASK_SEGMENTS)
+      throw std::runtime_error("task stack overflow");
+
+    Task* segment = (Task*) alignedMalloc(TASK_SEGMENT_SIZE*sizeof(Task),64);
+    for (size_t j=0; j<TASK_SEGMENT_SIZE; j++)
+      new (&segment[j]) Task();
+
+    /* publish the initialized segment to stealing threads */
+    segments[i].store(segment,std::memory_order_release);
+  }
+
+  dll_export void TaskScheduler::TaskQueue::allocBlock(size_t i) {
+    blocks[i] = (char*) alignedMalloc(CLOSURE_BLOCK_SIZE,64);
+  }
+
   bool TaskScheduler::TaskQueue::execute_local_internal(Thread& thread, Task* parent)
   {
     /* stop if we run out of local tasks or reach the waiting task */
-    if (right == 0 || &tasks[right-1] == parent)
+    if (right == 0 || &task(right-1) == parent)
       return false;
 
     /* execute task */
     size_t oldRight = right;
-    tasks[right-1].run_internal(thread);
+    task(right-1).run_internal(thread);
     if (right != oldRight) {
       THROW_RUNTIME_ERROR("you have to wait for spawned subtasks");
     }
 
     /* pop task and closure from stack */
     right--;
-    if (tasks[right].stackPtr != size_t(-1))
-      stackPtr = tasks[right].stackPtr;
+    if (task(right).stackPtr != size_t(-1))
+      stackPtr = task(right).stackPtr;
 
     /* also move left pointer */
     if (left >= right) left.store(right.load());
@@ -104,27 +145,31 @@ namespace embree
   {
     size_t l = left;
     size_t r = right;
-    if (l < r)
-    {
-      l = left++;
-       if (l >= r)
-         return false;
-    }
-    else
+    if (l >= r)
+      return false;
+
+    /* the stolen task is placed on the right of the stealing thread */
+    TaskQueue& tasks = thread.tasks;
+    tasks.reserve(tasks.right);
+
+    /* claim the leftmost task, only one thread can advance left past it */
+    if (!left.compare_exchange_strong(l,l+1))
       return false;
 
-    if (!tasks[l].try_steal(thread.tasks.tasks[thread.tasks.right]))
+    /* the owner may execute the task concurrently, the task state decides who runs it */
+    if (!task(l).try_steal(tasks.task(tasks.right)))
       return false;
 
-    thread.tasks.right++;
+    tasks.right++;
     return true;
   }
 
   /* we steal from the left */
   size_t TaskScheduler::TaskQueue::getTaskSizeAtLeft()
   {
-    if (left >= right) return 0;
-    return tasks[left].N;
+    size_t l = left;
+    if (l >= right) return 0;
+    return task(l).N;
   }
 
   void threadPoolFunction(std::pair<TaskScheduler::ThreadPool*,size_t>* pair)
@@ -135,8 +180,8 @@ namespace embree
     pool->thread_loop(threadIndex);
   }
 
-  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity, bool numa)
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), numa(numa && getNumberOfNUMANodes() > 1), running(false) {}
 
   dll_export void TaskScheduler::ThreadPool::startThreads()
   {
@@ -258,6 +303,19 @@ namespace embree
     return threadPool->size();
   }
 
+  dll_export unsigned int TaskScheduler::threadNUMANode()
+  {
+    Thread* thread = TaskScheduler::thread();
+    if (thread) return thread->numaNode.load(std::memory_order_relaxed);
+    else        return currentNUMANode();
+  }
+
+  dll_export unsigned int TaskScheduler::currentNUMANode()
+  {
+    if (!threadPool || !threadPool->numaAware()) return 0;
+    return getCurrentNUMANode();
+  }
+
   dll_export TaskScheduler* TaskScheduler::instance()
   {
     if (g_instance == NULL) {
@@ -268,9 +326,9 @@ namespace embree
     return g_instance;
   }
 
-  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads)
+  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads, bool numa)
   {
-    if (!threadPool) threadPool = new TaskScheduler::ThreadPool(set_affinity);
+    if (!threadPool) threadPool = new TaskScheduler::ThreadPool(set_affinity,numa);
     threadPool->setNumThreads(numThreads,start_threads);
   }
 
@@ -369,18 +427,30 @@ namespace embree
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
 
-    for (size_t i=1; i<threadCount; i++)
+    /* on NUMA systems we first steal from threads of the same node, as
+     * their tasks likely operate on memory of that node, and only then
+     * steal across nodes */
+    const bool numa = threadPool->numaAware();
+    const unsigned int numaNode = thread.numaNode.load(std::memory_order_relaxed);
+
+    for (size_t pass=0; pass<(numa ? 2 : 1); pass++)
     {
-      pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+      for (size_t i=1; i<threadCount; i++)
+      {
+        size_t otherThreadIndex = threadIndex+i;
+        if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
 
-      Thread* othread = threadLocal[otherThreadIndex].load();
-      if (!othread)
-        continue;
+        Thread* othread = threadLocal[otherThreadIndex].load();
+        if (!othread)
+          continue;
 
-      if (othread->tasks.steal(thread))
-        return true;
+        if (numa && (othread->numaNode.load(std::memory_order_relaxed) == numaNode) != (pass == 0))
+          continue;
+
+        pause_cpu(32);
+        if (othread->tasks.steal(thread))
+          return true;
+      }
     }
 
     return false;
@@ -24,8 +24,10 @@ namespace embree
     ALIGNED_STRUCT_(64);
     friend class Device;
 
-    static const size_t TASK_STACK_SIZE = 4*1024;           //!< task structure stack
-    static const size_t CLOSURE_STACK_SIZE = 512*1024;    //!< stack for task closures
+    static const size_t TASK_SEGMENT_SIZE = 4*1024;         //!< number of tasks per segment of the task deque
+    static const size_t MAX_TASK_SEGMENTS = 1024;           //!< maximal number of segments of the task deque
+    static const size_t CLOSURE_BLOCK_SIZE = 512*1024;      //!< size of the blocks of the closure arena
+    static const size_t MAX_CLOSURE_BLOCKS = 1024;          //!< maximal number of blocks of the closure arena
 
     struct Thread;
 
@@ -118,30 +120,57 @@ namespace embree
       size_t N;                          //!< approximative size of task
     };
 
+    /*! Work stealing deque of a thread. The owner pushes and pops tasks
+     *  at the right end, other threads steal from the left end. The tasks
+     *  are stored in segments and the closures in blocks of an arena that
+     *  both grow on demand and never move, as stolen tasks reference the
+     *  closure and parent task of the owner. */
     struct TaskQueue
     {
-      TaskQueue ()
-      : left(0), right(0), stackPtr(0) {}
+      dll_export TaskQueue ();
+      dll_export ~TaskQueue ();
+
+      /*! returns the i'th task of the deque */
+      __forceinline Task& task(size_t i) {
+        return segments[i/TASK_SEGMENT_SIZE].load(std::memory_order_acquire)[i%TASK_SEGMENT_SIZE];
+      }
+
+      /*! makes sure the segment of the i'th task is allocated */
+      __forceinline void reserve(size_t i)
+      {
+        if (unlikely(segments[i/TASK_SEGMENT_SIZE].load(std::memory_order_relaxed) == nullptr))
+          allocSegment(i/TASK_SEGMENT_SIZE);
+      }
 
       __forceinline void* alloc(size_t bytes, size_t align = 64)
       {
-        size_t ofs = bytes + ((align - stackPtr) & (align-1));
-        if (stackPtr + ofs > CLOSURE_STACK_SIZE)
+        size_t begin = (stackPtr + align-1) & ~(align-1);
+        size_t block = begin/CLOSURE_BLOCK_SIZE;
+
+        /* continue in the next block if the closure does not fit into the current one */
+        if (unlikely(begin+bytes > (block+1)*CLOSURE_BLOCK_SIZE)) {
+          block++;
+          begin = block*CLOSURE_BLOCK_SIZE;
+        }
+        if (unlikely(block >= MAX_CLOSURE_BLOCKS || bytes > CLOSURE_BLOCK_SIZE))
           throw std::runtime_error("closure stack overflow");
-        stackPtr += ofs;
-        return &stack[stackPtr-bytes];
+        if (unlikely(blocks[block] == nullptr))
+          allocBlock(block);
+
+        stackPtr = begin+bytes;
+        return &blocks[block][begin-block*CLOSURE_BLOCK_SIZE];
       }
 
       template<typename Closure>
       __forceinline void push_right(Thread& thread, const size_t size, const Closure& closure, TaskGroupContext* context)
       {
-        if (right >= TASK_STACK_SIZE)
-          throw std::runtime_error("task stack overflow");
+        const size_t r = right.load();
+        reserve(r);
 
 	/* allocate new task on right side of stack */
         size_t oldStackPtr = stackPtr;
         TaskFunction* func = new (alloc(sizeof(ClosureTaskFunction<Closure>))) ClosureTaskFunction<Closure>(closure);
-        new (&tasks[right.load()]) Task(func,thread.task,context,oldStackPtr,size);
+        new (&task(r)) Task(func,thread.task,context,oldStackPtr,size);
         right++;
 
 	/* also move left pointer */
@@ -155,15 +184,19 @@ namespace embree
 
       bool empty() { return right == 0; }
 
+    private:
+      dll_export void allocSegment(size_t i);
+      dll_export void allocBlock(size_t i);
+
     public:
 
-      /* task stack */
-      Task tasks[TASK_STACK_SIZE];
+      /* task deque */
+      std::atomic<Task*> segments[MAX_TASK_SEGMENTS];
       __aligned(64) std::atomic<size_t> left;   //!< threads steal from left
       __aligned(64) std::atomic<size_t> right;  //!< new tasks are added to the right
 
-      /* closure stack */
-      __aligned(64) char stack[CLOSURE_STACK_SIZE];
+      /* closure arena, used as a stack */
+      __aligned(64) char* blocks[MAX_CLOSURE_BLOCKS];
       size_t stackPtr;
     };
 
@@ -173,13 +206,14 @@ namespace embree
       ALIGNED_STRUCT_(64);
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {}
+      : threadIndex(threadIndex), numaNode(TaskScheduler::currentNUMANode()), task(nullptr), scheduler(scheduler) {}
 
       __forceinline size_t threadCount() {
           return scheduler->threadCounter;
       }
 
       size_t threadIndex;              //!< ID of this thread
+      std::atomic<unsigned int> numaNode; //!< NUMA node the thread last ran on
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
@@ -188,7 +222,7 @@ namespace embree
     /*! pool of worker threads */
     struct ThreadPool
     {
-      ThreadPool (bool set_affinity);
+      ThreadPool (bool set_affinity, bool numa);
       ~ThreadPool ();
 
       /*! starts the threads */
@@ -206,6 +240,9 @@ namespace embree
       /*! returns number of threads of the thread pool */
       size_t size() const { return numThreads; }
 
+      /*! returns true if the threads steal NUMA node local first */
+      bool numaAware() const { return numa; }
+
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
 
@@ -213,6 +250,7 @@ namespace embree
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
       bool set_affinity;
+      bool numa;
       std::atomic<bool> running;
       std::vector<thread_t> threads;
 
@@ -226,7 +264,7 @@ namespace embree
     ~TaskScheduler ();
 
     /*! initializes the task scheduler */
-    static void create(size_t numThreads, bool set_affinity, bool start_threads);
+    static void create(size_t numThreads, bool set_affinity, bool start_threads, bool numa);
 
     /*! destroys the task scheduler again */
     static void destroy();
@@ -337,6 +375,9 @@ namespace embree
     /* returns the total number of threads */
     dll_export static size_t threadCount();
 
+    /* returns the NUMA node the current thread runs on */
+    dll_export static unsigned int threadNUMANode();
+
   private:
 
     /* returns the thread local task list of this worker thread */
@@ -345,6 +386,9 @@ namespace embree
     /* sets the thread local task list of this worker thread */
     dll_export static Thread* swapThread(Thread* thread);
 
+    /*! returns the NUMA node of the calling thread, 0 if the thread pool is not NUMA aware */
+    dll_export static unsigned int currentNUMANode();
+
     /*! returns the taskscheduler object to be used by the master thread */
     dll_export static TaskScheduler* instance();
 
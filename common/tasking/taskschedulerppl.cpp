@@ -7,7 +7,7 @@ namespace embree
 {
   static bool g_ppl_threads_initialized = false;
     
-  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads)
+  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads, bool numa)
   {
     assert(numThreads);
     
@@ -23,7 +23,7 @@ namespace embree
 
   } tbb_affinity;
 
-  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads)
+  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads, bool numa)
   {
     assert(numThreads);
 
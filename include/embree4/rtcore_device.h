@@ -64,6 +64,7 @@ enum RTCDeviceProperty
   RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED   = 66,
   RTC_DEVICE_PROPERTY_IGNORE_INVALID_RAYS_ENABLED = 67,
   RTC_DEVICE_PROPERTY_COMPACT_POLYS_ENABLED       = 68,
+  RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_SAMPLING_RATE = 69,
 
   RTC_DEVICE_PROPERTY_TRIANGLE_GEOMETRY_SUPPORTED    = 96,
   RTC_DEVICE_PROPERTY_QUAD_GEOMETRY_SUPPORTED        = 97,
@@ -77,7 +78,20 @@ enum RTCDeviceProperty
   RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130,
 
   RTC_DEVICE_PROPERTY_CPU_DEVICE  = 140,
-  RTC_DEVICE_PROPERTY_SYCL_DEVICE = 141
+  RTC_DEVICE_PROPERTY_SYCL_DEVICE = 141,
+
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE      = 150,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MODE      = 151,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS      = 152,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES    = 153,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS = 154
+};
+
+/* Eviction policies of the tessellation cache */
+enum RTCTessellationCacheMode
+{
+  RTC_TESSELLATION_CACHE_MODE_SEGMENTED = 0,
+  RTC_TESSELLATION_CACHE_MODE_LRU       = 1
 };
 
 /* Gets a device property. */
@@ -122,4 +136,28 @@ typedef bool (*RTCMemoryMonitorFunction)(void* ptr, ssize_t bytes, bool post);
 /* Sets the memory monitor callback function. */
 RTC_API void rtcSetDeviceMemoryMonitorFunction(RTCDevice device, RTCMemoryMonitorFunction memoryMonitor, void* userPtr);
 
+/* Types of ray queries */
+enum RTCQueryType
+{
+  RTC_QUERY_TYPE_INTERSECT = 0,
+  RTC_QUERY_TYPE_OCCLUDED  = 1
+};
+
+/* Traversal statistics of one type of ray queries */
+struct RTCTraversalStatistics
+{
+  size_t numRays;        // number of rays traced
+  size_t numSampledRays; // number of rays traced by sampled queries
+  size_t numNodes;       // number of inner nodes visited by sampled queries
+  size_t numLeaves;      // number of leaves visited by sampled queries
+  size_t numPrimitives;  // number of primitive blocks intersected by sampled queries
+  size_t numFilterCalls; // number of filter function invocations of sampled queries
+};
+
+/* Gets the traversal statistics gathered by the device for some type of ray queries. */
+RTC_API void rtcGetDeviceTraversalStatistics(RTCDevice device, enum RTCQueryType type, struct RTCTraversalStatistics* statistics_o);
+
+/* Resets the traversal statistics of the device. */
+RTC_API void rtcResetDeviceTraversalStatistics(RTCDevice device);
+
 RTC_NAMESPACE_END
@@ -191,6 +191,9 @@ RTC_API void* rtcGetGeometryBufferDataDevice(RTCGeometry geometry, enum RTCBuffe
 /* Updates a geometry buffer. */
 RTC_API void rtcUpdateGeometryBuffer(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot);
 
+/* Updates a range of items of a geometry buffer. */
+RTC_API void rtcUpdateGeometryBufferRange(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount);
+
 /* Sets the intersection filter callback function of the geometry. */
 RTC_API void rtcSetGeometryIntersectFilterFunction(RTCGeometry geometry, RTCFilterFunctionN filter);
 
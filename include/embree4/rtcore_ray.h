@@ -183,6 +183,50 @@ struct RTCRayHit16
   struct RTCHit16 hit;
 };
 
+/* Ray structure for a stream of rays in SOA layout, pointing to one array per component */
+struct RTCRayNp
+{
+  float* org_x;        // x coordinate of ray origin
+  float* org_y;        // y coordinate of ray origin
+  float* org_z;        // z coordinate of ray origin
+  float* tnear;        // start of ray segment (optional)
+
+  float* dir_x;        // x coordinate of ray direction
+  float* dir_y;        // y coordinate of ray direction
+  float* dir_z;        // z coordinate of ray direction
+  float* time;         // time of this ray for motion blur (optional)
+
+  float* tfar;         // end of ray segment (set to hit distance)
+  unsigned int* mask;  // ray mask (optional)
+  unsigned int* id;    // ray ID (optional)
+  unsigned int* flags; // ray flags (optional)
+};
+
+/* Hit structure for a stream of rays in SOA layout, pointing to one array per component */
+struct RTCHitNp
+{
+  float* Ng_x;          // x coordinate of geometry normal (optional)
+  float* Ng_y;          // y coordinate of geometry normal (optional)
+  float* Ng_z;          // z coordinate of geometry normal (optional)
+
+  float* u;             // barycentric u coordinate of hit
+  float* v;             // barycentric v coordinate of hit
+
+  unsigned int* primID; // primitive ID
+  unsigned int* geomID; // geometry ID
+  unsigned int* instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID (optional)
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+  unsigned int* instPrimID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance primitive ID (optional)
+#endif
+};
+
+/* Combined ray/hit structure for a stream of rays in SOA layout */
+struct RTCRayHitNp
+{
+  struct RTCRayNp ray;
+  struct RTCHitNp hit;
+};
+
 struct RTCRayN;
 struct RTCHitN;
 struct RTCRayHitN;
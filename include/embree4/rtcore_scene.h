@@ -120,6 +120,9 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Commits multiple scenes concurrently, instanced scenes are committed before the scenes instancing them. */
+RTC_API void rtcCommitScenes(RTCScene* scenes, const int* priorities, unsigned int numScenes);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -142,6 +145,54 @@ RTC_API void rtcGetSceneBounds(RTCScene scene, struct RTCBounds* bounds_o);
 /* Returns the linear axis-aligned bounds of the scene. */
 RTC_API void rtcGetSceneLinearBounds(RTCScene scene, struct RTCLinearBounds* bounds_o);
 
+/* Build phases reported by the scene build statistics */
+enum RTCBuildPhase
+{
+  RTC_BUILD_PHASE_PRIMREF_GENERATION = 0,
+  RTC_BUILD_PHASE_PRESPLITS          = 1,
+  RTC_BUILD_PHASE_BINNING            = 2,
+  RTC_BUILD_PHASE_NODE_ALLOCATION    = 3,
+  RTC_BUILD_PHASE_LEAF_CREATION      = 4,
+  RTC_BUILD_PHASE_TWO_LEVEL_MERGE    = 5,
+  RTC_BUILD_PHASE_COUNT              = 6
+};
+
+/* Maximal number of acceleration structures reported by the scene build statistics */
+#define RTC_MAX_BUILD_STATISTICS_ACCEL_COUNT 32
+
+/* Statistics of one phase of an acceleration structure build */
+struct RTCBuildPhaseStatistics
+{
+  double time;              // wall clock time the phase was active in seconds
+  double threadTime;        // time spent by all threads in the phase in seconds
+  double threadUtilization; // threadTime divided by time and the number of build threads
+  size_t bytesAllocated;    // bytes allocated by the phase
+};
+
+/* Statistics of the last build of one acceleration structure of the scene */
+struct RTCAccelBuildStatistics
+{
+  char builder[64];         // name of the builder used
+  size_t numPrimitives;     // number of primitives built over
+  double time;              // wall clock time of the build in seconds
+  size_t bytesAllocated;    // bytes used by the acceleration structure
+  struct RTCBuildPhaseStatistics phases[RTC_BUILD_PHASE_COUNT];
+  size_t numFineBinningSplits; // number of splits found by coarse-to-fine binning
+  double fineBinningSAHSaved;  // fraction of the split SAH cost saved by coarse-to-fine binning
+};
+
+/* Statistics of the last commit of a scene */
+struct RTCSceneBuildStatistics
+{
+  double time;              // wall clock time of the commit in seconds
+  unsigned int numThreads;  // number of build threads
+  unsigned int numAccels;   // number of valid entries in accels
+  struct RTCAccelBuildStatistics accels[RTC_MAX_BUILD_STATISTICS_ACCEL_COUNT];
+};
+
+/* Returns the build statistics of the last commit of the scene. */
+RTC_API void rtcGetSceneBuildStatistics(RTCScene scene, struct RTCSceneBuildStatistics* statistics_o);
+
 #if !defined(__SYCL_DEVICE_ONLY__)
 
 /* Gets the user-defined data pointer of the geometry. This function is not thread safe and should get used during rendering. */
@@ -175,6 +226,12 @@ RTC_API void rtcIntersect8(const int* valid, RTCScene scene, struct RTCRayHit8*
 /* Intersects a packet of 16 rays with the scene. */
 RTC_API void rtcIntersect16(const int* valid, RTCScene scene, struct RTCRayHit16* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Intersects a stream of M rays in AOS layout with the scene. */
+RTC_API void rtcIntersect1M(RTCScene scene, struct RTCRayHit* rayhit, unsigned int M, size_t byteStride, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Intersects a stream of N rays in SOA layout with the scene. */
+RTC_API void rtcIntersectNp(RTCScene scene, const struct RTCRayHitNp* rayhit, unsigned int N, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
 
 /* Forwards ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardIntersect1(const struct RTCIntersectFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
@@ -213,6 +270,12 @@ RTC_API void rtcOccluded8(const int* valid, RTCScene scene, struct RTCRay8* ray,
 /* Tests a packet of 16 rays for occlusion with the scene. */
 RTC_API void rtcOccluded16(const int* valid, RTCScene scene, struct RTCRay16* ray, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Tests a stream of M rays in AOS layout for occlusion with the scene. */
+RTC_API void rtcOccluded1M(RTCScene scene, struct RTCRay* ray, unsigned int M, size_t byteStride, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Tests a stream of N rays in SOA layout for occlusion with the scene. */
+RTC_API void rtcOccludedNp(RTCScene scene, const struct RTCRayNp* ray, unsigned int N, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
 
 /* Forwards single occlusion ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardOccluded1(const struct RTCOccludedFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
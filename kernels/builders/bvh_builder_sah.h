@@ -29,12 +29,14 @@ namespace embree
         /*! default settings */
         Settings ()
         : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(7),
-          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf) {}
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf),
+          fineBinningThreshold(inf), fineBinningStatistics(nullptr) {}
 
         /*! initialize settings from API settings */
         Settings (const RTCBuildArguments& settings)
         : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(7),
-          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf)
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf),
+          fineBinningThreshold(inf), fineBinningStatistics(nullptr)
         {
           if (RTC_BUILD_ARGUMENTS_HAS(settings,maxBranchingFactor)) branchingFactor = settings.maxBranchingFactor;
           if (RTC_BUILD_ARGUMENTS_HAS(settings,maxDepth          )) maxDepth        = settings.maxDepth;
@@ -49,7 +51,8 @@ namespace embree
 
         Settings (size_t sahBlockSize, size_t minLeafSize, size_t maxLeafSize, float travCost, float intCost, size_t singleThreadThreshold, size_t primrefarrayalloc = inf)
         : branchingFactor(2), maxDepth(32), logBlockSize(bsr(sahBlockSize)), minLeafSize(min(minLeafSize,maxLeafSize)), maxLeafSize(maxLeafSize),
-          travCost(travCost), intCost(intCost), singleThreadThreshold(singleThreadThreshold), primrefarrayalloc(primrefarrayalloc)
+          travCost(travCost), intCost(intCost), singleThreadThreshold(singleThreadThreshold), primrefarrayalloc(primrefarrayalloc),
+          fineBinningThreshold(inf), fineBinningStatistics(nullptr)
         {
         }
 
@@ -63,6 +66,8 @@ namespace embree
         float intCost;           //!< estimated cost of one primitive intersection
         size_t singleThreadThreshold; //!< threshold when we switch to single threaded build
         size_t primrefarrayalloc;  //!< builder uses prim ref array to allocate nodes and leaves when a subtree of that size is finished
+        size_t fineBinningThreshold; //!< subtrees of at least that many primitives get binned coarse-to-fine
+        FineBinningStatistics* fineBinningStatistics; //!< optional statistics of coarse-to-fine binning
       };
 
       /*! recursive state of builder */
@@ -466,7 +471,7 @@ namespace embree
                                  PrimRef* prims, const PrimInfo& pinfo,
                                  const Settings& settings)
       {
-        Heuristic heuristic(prims);
+        Heuristic heuristic(prims,settings.fineBinningThreshold,settings.fineBinningStatistics);
         return GeneralBVHBuilder::build<ReductionTy,Heuristic,Set,PrimRef>(
           heuristic,
           prims,
@@ -499,7 +504,7 @@ namespace embree
                                  PrimRef* prims, const PrimInfo& pinfo,
                                  const Settings& settings)
       {
-        Heuristic heuristic(prims);
+        Heuristic heuristic(prims,settings.fineBinningThreshold,settings.fineBinningStatistics);
         return GeneralBVHBuilder::build<ReductionTy,Heuristic,Set,PrimRef>(
           heuristic,
           prims,
@@ -567,7 +572,7 @@ namespace embree
                                  const Settings& settings)
         {
           typedef HeuristicArraySpatialSAH<SplitPrimitiveFunc,PrimRef,NUM_OBJECT_BINS,NUM_SPATIAL_BINS> Heuristic;
-          Heuristic heuristic(splitPrimitive,prims,pinfo);
+          Heuristic heuristic(splitPrimitive,prims,pinfo,settings.fineBinningThreshold,settings.fineBinningStatistics);
 
           /* calculate total surface area */ // FIXME: this sum is not deterministic
           const float A = (float) parallel_reduce(size_t(0),pinfo.size(),0.0, [&] (const range<size_t>& r) -> double {
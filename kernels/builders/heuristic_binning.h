@@ -51,6 +51,18 @@ namespace embree
           ofs  = (vfloat4) pinfo.centBounds.lower;
         }
 
+        /*! calculates a mapping of the interval between the bins pos-1 and
+         *  pos+1 of some coarse mapping into num bins, the dimensions
+         *  other than dim are invalid */
+        __forceinline BinMapping(const BinMapping& coarse, size_t dim, size_t pos, size_t num)
+          : num(num), ofs(zero), scale(zero)
+        {
+          const float lower = coarse.pos(pos-1,dim);
+          const float upper = coarse.pos(pos+1,dim);
+          ofs[dim] = lower;
+          scale[dim] = float(num)/(upper-lower);
+        }
+
         /*! returns number of bins */
         __forceinline size_t size() const { return num; }
         
@@ -170,7 +182,50 @@ namespace embree
 
     typedef SplitInfoT<BBox3fa> SplitInfo;
     typedef SplitInfoT<LBBox3fa> SplitInfo2;
+
+    /*! counts the splits found by coarse-to-fine binning and the split
+     *  SAH cost it saved */
+    struct FineBinningStatistics
+    {
+      FineBinningStatistics ()
+        : numSplits(0), sahDefault(0.0), sahSaved(0.0) {}
+
+      __forceinline void add(float coarseSAH, float fineSAH)
+      {
+        numSplits++;
+        add(sahDefault,coarseSAH);
+        add(sahSaved,coarseSAH-min(coarseSAH,fineSAH));
+      }
+
+    private:
+      __forceinline static void add(std::atomic<double>& sum, float value)
+      {
+        double s = sum.load();
+        while (!sum.compare_exchange_weak(s,s+double(value)));
+      }
+
+    public:
+      std::atomic<size_t> numSplits;   //!< number of splits that got binned coarse-to-fine
+      std::atomic<double> sahDefault;  //!< sum of the SAH costs of these splits with default binning
+      std::atomic<double> sahSaved;    //!< sum of the SAH costs saved by the fine binning
+    };
     
+#if defined(__AVX2__)
+    /*! loads the doubled centroids of VSIZEL primitive references in SoA layout */
+    __forceinline void loadCenter2(const PrimRef* prims, vfloat<VSIZEL>& cx, vfloat<VSIZEL>& cy, vfloat<VSIZEL>& cz)
+    {
+      vfloat4 c[VSIZEL];
+      for (size_t i=0; i<VSIZEL; i++)
+        c[i] = vfloat4::load((float*)&prims[i].lower) + vfloat4::load((float*)&prims[i].upper);
+#if defined(__AVX512VL__)
+      vfloat16 cw;
+      transpose(c[0],c[1],c[2],c[3],c[4],c[5],c[6],c[7],c[8],c[9],c[10],c[11],c[12],c[13],c[14],c[15],cx,cy,cz,cw);
+#else
+      transpose(c[0],c[1],c[2],c[3],c[4],c[5],c[6],c[7],cx,cy,cz);
+#endif
+    }
+#endif
+
     /*! stores all binning information */
     template<size_t BINS, typename PrimRef, typename BBox>
       struct __aligned(64) BinInfoT
@@ -209,6 +264,66 @@ namespace embree
       /*! bins an array of primitives */
       __forceinline void bin (const PrimRef* prims, size_t N, const BinMapping<BINS>& mapping)
       {
+#if defined(__AVX2__)
+        /* the SIMD path pays for clearing and merging a second histogram */
+        if (N >= 8*VSIZEL) {
+          bin_simd(prims,N,mapping,std::integral_constant<bool,std::is_same<PrimRef,embree::PrimRef>::value && std::is_same<BBox,BBox3fa>::value>());
+          return;
+        }
+#endif
+        bin_scalar(prims,N,mapping);
+      }
+
+#if defined(__AVX2__)
+      __forceinline void bin_simd (const PrimRef* prims, size_t N, const BinMapping<BINS>& mapping, std::false_type) {
+        bin_scalar(prims,N,mapping);
+      }
+
+      /*! bins VSIZEL primitive references per iteration: the bin IDs get
+       *  calculated in SIMD, and even and odd lanes update two private
+       *  histograms, such that consecutive primitives of the same bin do
+       *  not wait for each other's bounds updates */
+      __forceinline void bin_simd (const PrimRef* prims, size_t N, const BinMapping<BINS>& mapping, std::true_type)
+      {
+        typedef embree::vfloat<VSIZEL> vfloatl;
+        typedef embree::vint<VSIZEL> vintl;
+        
+        BinInfoT odd(empty);
+        const vfloatl ofsx(mapping.ofs[0]), ofsy(mapping.ofs[1]), ofsz(mapping.ofs[2]);
+        const vfloatl scalex(mapping.scale[0]), scaley(mapping.scale[1]), scalez(mapping.scale[2]);
+        const vintl maxBin(int(mapping.size()-1));
+
+        size_t i=0;
+        for (; i+VSIZEL<=N; i+=VSIZEL)
+        {
+          /*! map VSIZEL primitives to bins, clamping handles corner cases as in BinMapping::bin */
+          vfloatl cx,cy,cz; loadCenter2(prims+i,cx,cy,cz);
+          __aligned(64) int bx[VSIZEL], by[VSIZEL], bz[VSIZEL];
+          vintl::store(bx,clamp(floori((cx-ofsx)*scalex),vintl(zero),maxBin));
+          vintl::store(by,clamp(floori((cy-ofsy)*scaley),vintl(zero),maxBin));
+          vintl::store(bz,clamp(floori((cz-ofsz)*scalez),vintl(zero),maxBin));
+
+          for (size_t j=0; j<VSIZEL; j+=2)
+          {
+            const BBox3fa prim0 = prims[i+j+0].bounds();
+            bounds(bx[j+0],0).extend(prim0); counts(bx[j+0],0)++;
+            bounds(by[j+0],1).extend(prim0); counts(by[j+0],1)++;
+            bounds(bz[j+0],2).extend(prim0); counts(bz[j+0],2)++;
+
+            const BBox3fa prim1 = prims[i+j+1].bounds();
+            odd.bounds(bx[j+1],0).extend(prim1); odd.counts(bx[j+1],0)++;
+            odd.bounds(by[j+1],1).extend(prim1); odd.counts(by[j+1],1)++;
+            odd.bounds(bz[j+1],2).extend(prim1); odd.counts(bz[j+1],2)++;
+          }
+        }
+        bin_scalar(prims+i,N-i,mapping);
+        merge(odd,mapping.size());
+      }
+#endif
+
+      /*! bins an array of primitives two at a time */
+      __forceinline void bin_scalar (const PrimRef* prims, size_t N, const BinMapping<BINS>& mapping)
+      {
 	if (unlikely(N == 0)) return;
 	size_t i; 
 	for (i=0; i<N-1; i+=2)
@@ -308,6 +423,38 @@ namespace embree
 	bin<BinBoundsAndCenter>(prims+begin,end-begin,mapping,binBoundsAndCenter);
       }
 
+      /*! initializes the first and last fine bins of dimension dim with
+       *  the coarse bins left of pos-1 and right of pos */
+      __forceinline void seed (const BinInfoT& coarse, const BinMapping<BINS>& coarseMapping, size_t dim, size_t pos, const BinMapping<BINS>& fineMapping)
+      {
+        const size_t last = fineMapping.size()-1;
+        for (size_t i=0; i+1<pos; i++) {
+          counts(0,dim) += coarse.counts(i,dim);
+          bounds(0,dim).extend(coarse.bounds(i,dim));
+        }
+        for (size_t i=pos+1; i<coarseMapping.size(); i++) {
+          counts(last,dim) += coarse.counts(i,dim);
+          bounds(last,dim).extend(coarse.bounds(i,dim));
+        }
+      }
+
+      /*! bins the primitives that the coarse mapping maps to the bins
+       *  pos-1 and pos of dimension dim into the fine bins */
+      __forceinline void bin_fine (const PrimRef* prims, size_t N, const BinMapping<BINS>& coarseMapping, size_t dim, size_t pos, const BinMapping<BINS>& fineMapping)
+      {
+        for (size_t i=0; i<N; i++)
+        {
+          BBox prim; Vec3fa center;
+          prims[i].binBoundsAndCenter(prim,center);
+          const size_t b = coarseMapping.bin(center)[dim];
+          if (b+1 != pos && b != pos) continue;
+          
+          const size_t f = fineMapping.bin(center)[dim];
+          counts(f,dim) += (unsigned int)prims[i].size();
+          bounds(f,dim).extend(prim);
+        }
+      }
+
       /*! merges in other binning information */
       __forceinline void merge (const BinInfoT& other, size_t numBins)
       {
@@ -538,6 +685,43 @@ namespace embree
     }
   }
 
+  /*! coarse-to-fine binning: re-bins the primitives of the two bins
+   *  around the plane of the coarse split at higher resolution, the
+   *  number of fine bins grows with the number of these primitives. The
+   *  binning information and split are replaced when the fine split has
+   *  lower SAH cost. */
+  template<bool parallel, typename BinInfoT, typename Split, typename PrimRef>
+  __forceinline void refine_serial_or_parallel(BinInfoT& binner, Split& split, const PrimRef* prims, size_t begin, size_t end, size_t blockSize, size_t logBlockSize, isa::FineBinningStatistics* stats)
+  {
+    if (unlikely(!split.valid())) return;
+
+    const size_t dim = split.dim;
+    const size_t pos = split.pos;
+    const size_t numFine = binner.counts(pos-1,dim) + binner.counts(pos,dim);
+    if (numFine < 2) return;
+    
+    const size_t numBins = min(split.mapping.size(),size_t(4.0f + 0.05f*numFine));
+    const decltype(split.mapping) coarseMapping = split.mapping;
+    const decltype(split.mapping) fineMapping(coarseMapping,dim,pos,numBins);
+
+    BinInfoT fine(empty);
+    if (!parallel) {
+      fine.bin_fine(prims+begin,end-begin,coarseMapping,dim,pos,fineMapping);
+    } else {
+      fine = parallel_reduce(begin,end,blockSize,fine,
+                             [&](const range<size_t>& r) -> BinInfoT { BinInfoT fine(empty); fine.bin_fine(prims + r.begin(), r.size(), coarseMapping, dim, pos, fineMapping); return fine; },
+                             [&](const BinInfoT& b0, const BinInfoT& b1) -> BinInfoT { BinInfoT r = b0; r.merge(b1, fineMapping.size()); return r; });
+    }
+    fine.seed(binner,coarseMapping,dim,pos,fineMapping);
+
+    const Split fineSplit = fine.best(fineMapping,logBlockSize);
+    if (stats) stats->add(split.sah,fineSplit.sah);
+    if (!(fineSplit.sah < split.sah)) return;
+    
+    binner = fine;
+    split = fineSplit;
+  }
+
   template<bool parallel, typename BinBoundsAndCenter, typename BinInfoT, typename BinMapping, typename PrimRef>
   __forceinline void bin_serial_or_parallel(BinInfoT& binner, const PrimRef* prims, size_t begin, size_t end, size_t blockSize, const BinMapping& mapping, const BinBoundsAndCenter& binBoundsAndCenter)
   {
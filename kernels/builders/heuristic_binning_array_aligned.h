@@ -86,11 +86,11 @@ namespace embree
         static const size_t PARALLEL_PARTITION_BLOCK_SIZE = 128;
 
         __forceinline HeuristicArrayBinningSAH ()
-          : prims(nullptr) {}
+          : prims(nullptr), fineBinningThreshold(inf), fineBinningStatistics(nullptr) {}
 
         /*! remember prim array */
-        __forceinline HeuristicArrayBinningSAH (PrimRef* prims)
-          : prims(prims) {}
+        __forceinline HeuristicArrayBinningSAH (PrimRef* prims, size_t fineBinningThreshold = inf, FineBinningStatistics* fineBinningStatistics = nullptr)
+          : prims(prims), fineBinningThreshold(fineBinningThreshold), fineBinningStatistics(fineBinningStatistics) {}
 
         /*! finds the best split */
         __noinline const Split find(const PrimInfoRange& pinfo, const size_t logBlockSize)
@@ -107,7 +107,10 @@ namespace embree
           Binner binner(empty);
           const BinMapping<BINS> mapping(pinfo);
           bin_serial_or_parallel<parallel>(binner,prims,pinfo.begin(),pinfo.end(),PARALLEL_FIND_BLOCK_SIZE,mapping);
-          return binner.best(mapping,logBlockSize);
+          Split split = binner.best(mapping,logBlockSize);
+          if (unlikely(pinfo.size() >= fineBinningThreshold))
+            refine_serial_or_parallel<parallel>(binner,split,prims,pinfo.begin(),pinfo.end(),PARALLEL_FIND_BLOCK_SIZE,logBlockSize,fineBinningStatistics);
+          return split;
         }
 
         /*! finds the best split */
@@ -200,6 +203,8 @@ namespace embree
 
       private:
         PrimRef* const prims;
+        const size_t fineBinningThreshold;                   //!< subsets of at least that many primitives get binned coarse-to-fine
+        FineBinningStatistics* const fineBinningStatistics;  //!< optional statistics of coarse-to-fine binning
       };
 
 #if !defined(RTHWIF_STANDALONE)
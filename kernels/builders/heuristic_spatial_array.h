@@ -115,11 +115,13 @@ namespace embree
         static const size_t CREATE_SPLITS_STEP_SIZE = 64;
 
         __forceinline HeuristicArraySpatialSAH ()
-          : prims0(nullptr) {}
+          : prims0(nullptr), fineBinningThreshold(inf), fineBinningStatistics(nullptr) {}
         
         /*! remember prim array */
-        __forceinline HeuristicArraySpatialSAH (const PrimitiveSplitterFactory& splitterFactory, PrimRef* prims0, const CentGeomBBox3fa& root_info)
-          : prims0(prims0), splitterFactory(splitterFactory), root_info(root_info) {}
+        __forceinline HeuristicArraySpatialSAH (const PrimitiveSplitterFactory& splitterFactory, PrimRef* prims0, const CentGeomBBox3fa& root_info,
+                                                size_t fineBinningThreshold = inf, FineBinningStatistics* fineBinningStatistics = nullptr)
+          : prims0(prims0), splitterFactory(splitterFactory), root_info(root_info),
+            fineBinningThreshold(fineBinningThreshold), fineBinningStatistics(fineBinningStatistics) {}
 
 
         /*! compute extended ranges */
@@ -210,7 +212,9 @@ namespace embree
           const BinMapping<OBJECT_BINS> mapping(set);
           binner.bin(prims0,set.begin(),set.end(),mapping);
           ObjectSplit s = binner.best(mapping,logBlockSize);
-          binner.getSplitInfo(mapping, s, info);
+          if (unlikely(set.size() >= fineBinningThreshold))
+            refine_serial_or_parallel<false>(binner,s,prims0,set.begin(),set.end(),PARALLEL_FIND_BLOCK_SIZE,logBlockSize,fineBinningStatistics);
+          binner.getSplitInfo(s.mapping, s, info);
           return s;
         }
 
@@ -224,7 +228,9 @@ namespace embree
                                    [&] (const range<size_t>& r) -> ObjectBinner { ObjectBinner binner(empty); binner.bin(prims0+r.begin(),r.size(),_mapping); return binner; },
                                    [&] (const ObjectBinner& b0, const ObjectBinner& b1) -> ObjectBinner { ObjectBinner r = b0; r.merge(b1,_mapping.size()); return r; });
           ObjectSplit s = binner.best(mapping,logBlockSize);
-          binner.getSplitInfo(mapping, s, info);
+          if (unlikely(set.size() >= fineBinningThreshold))
+            refine_serial_or_parallel<true>(binner,s,prims0,set.begin(),set.end(),PARALLEL_FIND_BLOCK_SIZE,logBlockSize,fineBinningStatistics);
+          binner.getSplitInfo(s.mapping, s, info);
           return s;
         }
 
@@ -540,6 +546,8 @@ namespace embree
         PrimRef* const prims0;
         const PrimitiveSplitterFactory& splitterFactory;
         const CentGeomBBox3fa& root_info;
+        const size_t fineBinningThreshold;                   //!< subsets of at least that many primitives get binned coarse-to-fine
+        FineBinningStatistics* const fineBinningStatistics;  //!< optional statistics of coarse-to-fine binning
       };
   }
 }
@@ -32,6 +32,25 @@ namespace embree
       return pinfo;
     }
 
+    PrimInfo createPrimRefArray(Geometry* geometry, unsigned int geomID, const range<size_t>& r, mvector<PrimRef>& prims)
+    {
+      ParallelPrefixSumState<PrimInfo> pstate;
+
+      /* first try */
+      PrimInfo pinfo = parallel_prefix_sum( pstate, r.begin(), r.end(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r0, const PrimInfo& base) -> PrimInfo {
+          return geometry->createPrimRefArray(prims,r0,r0.begin()-r.begin(),geomID);
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+      /* if we need to filter out geometry, run again */
+      if (pinfo.size() != r.size())
+      {
+        pinfo = parallel_prefix_sum( pstate, r.begin(), r.end(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r0, const PrimInfo& base) -> PrimInfo {
+          return geometry->createPrimRefArray(prims,r0,base.size(),geomID);
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
+      return pinfo;
+    }
+
     PrimInfo createPrimRefArray(Scene* scene, Geometry::GTypeMask types, bool mblur, const size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
       ParallelForForPrefixSumState<PrimInfo> pstate;
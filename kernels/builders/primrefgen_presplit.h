@@ -228,8 +228,9 @@ namespace embree
 #if !defined(RTHWIF_STANDALONE)
 
     template<typename Mesh, typename SplitterFactory>    
-      PrimInfo createPrimRefArray_presplit(Geometry* geometry, unsigned int geomID, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+      PrimInfo createPrimRefArray_presplit(Geometry* geometry, unsigned int geomID, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, BuildStatistics& statistics)
     {
+      BuildPhaseTimer primrefTimer(statistics,BuildStatistics::PRIMREF_GENERATION);
       ParallelPrefixSumState<PrimInfo> pstate;
       
       /* first try */
@@ -246,6 +247,7 @@ namespace embree
 	      return geometry->createPrimRefArray(prims,r,base.size(),geomID);
 	    }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
 	}
+      primrefTimer.stop(prims.size()*sizeof(PrimRef));
       return pinfo;	
     }
 #endif
@@ -424,8 +426,9 @@ namespace embree
 #if !defined(RTHWIF_STANDALONE)
     
      template<typename Mesh, typename SplitterFactory>    
-      PrimInfo createPrimRefArray_presplit(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+      PrimInfo createPrimRefArray_presplit(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, BuildStatistics& statistics)
     {
+      BuildPhaseTimer primrefTimer(statistics,BuildStatistics::PRIMREF_GENERATION);
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator2 iter(scene,types,mblur);
 
@@ -444,8 +447,9 @@ namespace embree
 	      return mesh->createPrimRefArray(prims,r,base.size(),(unsigned)geomID);
 	    }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
 	}
+      primrefTimer.stop(prims.size()*sizeof(PrimRef));
 
-
+      BuildPhaseTimer presplitTimer(statistics,BuildStatistics::PRESPLITS);
       SplitterFactory Splitter(scene);
         
       auto split_primitive = [&] (const PrimRef &prim,
@@ -464,7 +468,9 @@ namespace embree
         return ((Mesh*)scene->get(geomID))->projectedPrimitiveArea(primID);
       };
       
-      return createPrimRefArray_presplit(numPrimRefs,prims,pinfo,split_primitive,primitiveArea);
+      const PrimInfo pinfo1 = createPrimRefArray_presplit(numPrimRefs,prims,pinfo,split_primitive,primitiveArea);
+      presplitTimer.stop(2*prims.size()*sizeof(PresplitItem));
+      return pinfo1;
     }
 #endif 
   }
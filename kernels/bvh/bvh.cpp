@@ -4,13 +4,34 @@
 #include "bvh.h"
 #include "bvh_statistics.h"
 
+#include <fstream>
+
 namespace embree
 {
+  /*! header of a BVH cache file, the node and leaf image directly follows */
+  struct BVHCacheHeader
+  {
+    char magic[8];           //!< identifies BVH cache files
+    uint32_t version;        //!< version of the file layout
+    uint32_t N;              //!< branching factor of the BVH
+    uint64_t key;            //!< hash of geometry data and build settings
+    char primTy[64];         //!< name of the stored primitive type
+    uint64_t numPrimitives;  //!< number of primitives the BVH was built over
+    uint64_t bytes;          //!< size of the node and leaf image
+    uint64_t root;           //!< root reference, stores an offset into the image instead of a pointer
+    LBBox3fa bounds;         //!< bounds of the BVH
+  };
+
+  static const char bvhCacheMagic[8] = { 'E','M','B','R','B','V','H','C' };
+  static const uint32_t bvhCacheVersion = 1;
+
   template<int N>
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(&primTy), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
+      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0),
+      refitTime(0.0), numRefitNodes(0), numRefitLeaves(0),
+      optimizeTime(0.0), optimizeSAHBefore(0.0), optimizeSAHAfter(0.0)
   {
   }
 
@@ -109,11 +130,155 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  static bool cacheImageBytes(const BVHN<N>* bvh, const typename BVHN<N>::NodeRef node, size_t& bytes)
+  {
+    if (node.isAABBNode())
+    {
+      bytes += sizeof(typename BVHN<N>::AABBNode);
+      const typename BVHN<N>::AABBNode* n = node.getAABBNode();
+      for (size_t c=0; c<N; c++)
+        if (!cacheImageBytes(bvh,n->child(c),bytes)) return false;
+      return true;
+    }
+    else if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      for (size_t i=0; i<num; i++) {
+        const size_t b = bvh->primTy->getBytes(prims);
+        bytes += b; prims += b;
+      }
+      return true;
+    }
+    /* only static AABB BVHs are cached */
+    return false;
+  }
+
+  template<int N>
+  static typename BVHN<N>::NodeRef writeCacheImage(const BVHN<N>* bvh, const typename BVHN<N>::NodeRef node, char* image, size_t& ofs)
+  {
+    typedef typename BVHN<N>::AABBNode AABBNode;
+
+    /* references get encoded with image offsets instead of pointers to make the image relocatable */
+    if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      if (num == 0) return node;
+      const size_t begin = ofs;
+      for (size_t i=0; i<num; i++) {
+        const size_t b = bvh->primTy->getBytes(prims);
+        memcpy(image+ofs,prims,b);
+        ofs += b; prims += b;
+      }
+      return BVHN<N>::encodeLeaf((void*)begin,num);
+    }
+
+    const size_t begin = ofs;
+    ofs += sizeof(AABBNode);
+    AABBNode* dst = (AABBNode*) (image+begin);
+    *dst = *node.getAABBNode();
+    for (size_t c=0; c<N; c++)
+      dst->child(c) = writeCacheImage(bvh,dst->child(c),image,ofs);
+    return BVHN<N>::encodeNode((AABBNode*)begin);
+  }
+
+  template<int N>
+  static bool relocateCacheImage(typename BVHN<N>::NodeRef& node, char* image, size_t bytes)
+  {
+    typedef typename BVHN<N>::AABBNode AABBNode;
+    
+    const size_t ofs = node & ~(size_t)BVHN<N>::NodeRef::align_mask;
+    if (node.isLeaf())
+    {
+      size_t num; node.leaf(num);
+      if (num == 0) return true;
+      if (ofs >= bytes) return false;
+      node = BVHN<N>::encodeLeaf(image+ofs,num);
+      return true;
+    }
+    else if (node.isAABBNode())
+    {
+      if (ofs+sizeof(AABBNode) > bytes) return false;
+      node = BVHN<N>::encodeNode((AABBNode*)(image+ofs));
+      AABBNode* n = node.getAABBNode();
+      for (size_t c=0; c<N; c++)
+        if (!relocateCacheImage<N>(n->child(c),image,bytes)) return false;
+      return true;
+    }
+    return false;
+  }
+
+  template<int N>
+  bool BVHN<N>::saveCache(const FileName& fileName, uint64_t key)
+  {
+    size_t bytes = 0;
+    if (!cacheImageBytes(this,root,bytes))
+      return false;
+
+    BVHCacheHeader header;
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,bvhCacheMagic,sizeof(header.magic));
+    header.version = bvhCacheVersion;
+    header.N = N;
+    header.key = key;
+    strncpy(header.primTy,primTy->name(),sizeof(header.primTy)-1);
+    header.numPrimitives = numPrimitives;
+    header.bytes = bytes;
+    header.bounds = bounds;
+
+    std::unique_ptr<char,decltype(&alignedFree)> image((char*)alignedMalloc(max(bytes,size_t(1)),64),&alignedFree);
+    size_t ofs = 0;
+    header.root = writeCacheImage(this,root,image.get(),ofs);
+    assert(ofs == bytes);
+
+    /* write to temporary file first, such that concurrent readers never see partially written files */
+    const FileName tmpFileName = fileName.str() + ".tmp";
+    {
+      std::ofstream file(tmpFileName.str(),std::ios::binary|std::ios::trunc);
+      if (!file) return false;
+      file.write((const char*)&header,sizeof(header));
+      file.write(image.get(),bytes);
+      if (!file) return false;
+    }
+    return std::rename(tmpFileName.c_str(),fileName.c_str()) == 0;
+  }
+
+  template<int N>
+  bool BVHN<N>::loadCache(const FileName& fileName, uint64_t key)
+  {
+    std::ifstream file(fileName.str(),std::ios::binary);
+    if (!file) return false;
+
+    BVHCacheHeader header;
+    file.read((char*)&header,sizeof(header));
+    if (!file) return false;
+    
+    if (memcmp(header.magic,bvhCacheMagic,sizeof(header.magic)) != 0) return false;
+    if (header.version != bvhCacheVersion || header.N != N || header.key != key) return false;
+    if (strncmp(header.primTy,primTy->name(),sizeof(header.primTy)) != 0) return false;
+
+    /* the image gets read into a single allocator block and pointers get patched in place */
+    alloc.clear();
+    char* image = (char*) alloc.mallocContiguous(max(size_t(header.bytes),size_t(1)));
+    file.read(image,header.bytes);
+    NodeRef node(header.root);
+    if (!file || !relocateCacheImage<N>(node,image,header.bytes)) {
+      clear();
+      return false;
+    }
+    set(node,header.bounds,header.numPrimitives);
+    return true;
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
+    buildStatistics.reset();
+    buildStatistics.builder = builderName;
+    const double t0 = getSeconds();
+
     if (builderName == "") 
-      return inf;
+      return t0;
 
     if (device->verbosity(2))
     {
@@ -121,20 +286,21 @@ namespace embree
       std::cout << "building BVH" << N << (builderName.find("MBlur") != std::string::npos ? "MB" : "") << "<" << primTy->name() << "> using " << builderName << " ..." << std::endl << std::flush;
     }
 
-    double t0 = 0.0;
-    if (device->benchmark || device->verbosity(2)) t0 = getSeconds();
     return t0;
   }
 
   template<int N>
   void BVHN<N>::postBuild(double t0)
   {
-    if (t0 == double(inf))
+    const double dt = getSeconds()-t0;
+    buildStatistics.numPrimitives = numPrimitives;
+    buildStatistics.time = dt;
+    buildStatistics.bytesAllocated = alloc.getUsedBytes();
+    for (size_t i=0; i<objects.size(); i++)
+      if (objects[i]) buildStatistics.bytesAllocated += objects[i]->alloc.getUsedBytes();
+
+    if (buildStatistics.builder == "")
       return;
-    
-    double dt = 0.0;
-    if (device->benchmark || device->verbosity(2)) 
-      dt = getSeconds()-t0;
 
     std::unique_ptr<BVHNStatistics<N>> stat;
 
@@ -107,6 +107,12 @@ namespace embree
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
     
+    /*! writes the BVH as relocatable image to a cache file, fails for unsupported node types */
+    bool saveCache(const FileName& fileName, uint64_t key);
+
+    /*! loads a BVH image written by saveCache, fails if the file is missing or was written for a different key */
+    bool loadCache(const FileName& fileName, uint64_t key);
+
     /*! called by all builders before build starts */
     double preBuild(const std::string& builderName);
     
@@ -223,6 +229,12 @@ namespace embree
   public:
     size_t numPrimitives;              //!< number of primitives the BVH is build over
     size_t numVertices;                //!< number of vertices the BVH references
+    double refitTime;                  //!< duration of the last refit in seconds
+    size_t numRefitNodes;              //!< number of inner nodes updated by the last refit
+    size_t numRefitLeaves;             //!< number of leaves updated by the last refit
+    double optimizeTime;               //!< duration of the post-build optimization in seconds
+    double optimizeSAHBefore;          //!< SAH cost before the post-build optimization
+    double optimizeSAHAfter;           //!< SAH cost after the post-build optimization
     
     /*! data arrays for special builders */
   public:
@@ -38,9 +38,11 @@ namespace embree
 
     Accel* BVH8Instance(Scene* scene, bool isExpensive, BuildVariant bvariant = BuildVariant::STATIC);
     Accel* BVH8InstanceMB(Scene* scene, bool isExpensive);
+    Accel* BVH8QuantizedInstance(Scene* scene, bool isExpensive);
 
     Accel* BVH8InstanceArray(Scene* scene, BuildVariant bvariant = BuildVariant::STATIC);
     Accel* BVH8InstanceArrayMB(Scene* scene);
+    Accel* BVH8QuantizedInstanceArray(Scene* scene);
 
     Accel* BVH8Grid(Scene* scene, BuildVariant bvariant = BuildVariant::STATIC, IntersectVariant ivariant = IntersectVariant::FAST);
     Accel* BVH8GridMB(Scene* scene, BuildVariant bvariant = BuildVariant::STATIC, IntersectVariant ivariant = IntersectVariant::FAST);
@@ -72,9 +74,11 @@ namespace embree
 
     Accel::Intersectors BVH8InstanceIntersectors(BVH8* bvh);
     Accel::Intersectors BVH8InstanceMBIntersectors(BVH8* bvh);
+    Accel::Intersectors QBVH8InstanceIntersectors(BVH8* bvh);
 
     Accel::Intersectors BVH8InstanceArrayIntersectors(BVH8* bvh);
     Accel::Intersectors BVH8InstanceArrayMBIntersectors(BVH8* bvh);
+    Accel::Intersectors QBVH8InstanceArrayIntersectors(BVH8* bvh);
 
     Accel::Intersectors BVH8GridIntersectors(BVH8* bvh, IntersectVariant ivariant);
     Accel::Intersectors BVH8GridMBIntersectors(BVH8* bvh, IntersectVariant ivariant);
@@ -120,6 +124,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8InstanceArrayIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8InstanceArrayMBIntersector1);
 
+    DEFINE_SYMBOL2(Accel::Intersector1,QBVH8InstanceIntersector1);
+    DEFINE_SYMBOL2(Accel::Intersector1,QBVH8InstanceArrayIntersector1);
+
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8GridIntersector1Moeller);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8GridMBIntersector1Moeller);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8GridIntersector1Pluecker);
@@ -149,6 +156,10 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8Triangle4iIntersector4HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8Triangle4Intersector4HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8Quad4iIntersector4HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8VirtualIntersector4Chunk);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8VirtualMBIntersector4Chunk);
 
@@ -158,6 +169,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8InstanceArrayIntersector4Chunk);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8InstanceArrayMBIntersector4Chunk);
 
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8InstanceIntersector4Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8InstanceArrayIntersector4Chunk);
+
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8GridIntersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8GridIntersector4HybridPluecker);
 
@@ -186,6 +200,10 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8Triangle4iIntersector8HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8Triangle4Intersector8HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8Quad4iIntersector8HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8VirtualIntersector8Chunk);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8VirtualMBIntersector8Chunk);
 
@@ -195,6 +213,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8InstanceArrayIntersector8Chunk);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8InstanceArrayMBIntersector8Chunk);
 
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8InstanceIntersector8Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8InstanceArrayIntersector8Chunk);
+
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8GridIntersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8GridIntersector8HybridPluecker);
 
@@ -223,6 +244,10 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8Triangle4iIntersector16HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8Triangle4Intersector16HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8Quad4iIntersector16HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8VirtualIntersector16Chunk);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8VirtualMBIntersector16Chunk);
 
@@ -232,6 +257,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8InstanceArrayIntersector16Chunk);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8InstanceArrayMBIntersector16Chunk);
 
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8InstanceIntersector16Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8InstanceArrayIntersector16Chunk);
+
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8GridIntersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8GridIntersector16HybridPluecker);
 
@@ -262,6 +290,9 @@ namespace embree
     DEFINE_ISA_FUNCTION(Builder*,BVH8InstanceArraySceneBuilderSAH,void* COMMA Scene* COMMA Geometry::GTypeMask);
     DEFINE_ISA_FUNCTION(Builder*,BVH8InstanceArrayMBSceneBuilderSAH,void* COMMA Scene* COMMA Geometry::GTypeMask);
 
+    DEFINE_ISA_FUNCTION(Builder*,BVH8QuantizedInstanceSceneBuilderSAH,void* COMMA Scene* COMMA Geometry::GTypeMask);
+    DEFINE_ISA_FUNCTION(Builder*,BVH8QuantizedInstanceArraySceneBuilderSAH,void* COMMA Scene* COMMA Geometry::GTypeMask);
+
     DEFINE_ISA_FUNCTION(Builder*,BVH8GridSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH8GridMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
 
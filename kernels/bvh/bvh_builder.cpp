@@ -7,8 +7,19 @@ namespace embree
 {
   namespace isa
   {
+    size_t fineBinningThreshold(const Device* device, RTCBuildQuality quality)
+    {
+      if (device->fine_binning_threshold > 0)
+        return device->fine_binning_threshold;
+
+      if (device->fine_binning_threshold < 0 && quality == RTC_BUILD_QUALITY_HIGH)
+        return 4096;
+
+      return inf;
+    }
+
     template<int N>
-    typename BVHN<N>::NodeRef BVHNBuilderVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings)
+    typename BVHN<N>::NodeRef BVHNBuilderVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, BuildStatistics& statistics)
     {
       auto createLeafFunc = [&] (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) -> NodeRef {
         return createLeaf(prims,set,alloc);
@@ -16,13 +27,18 @@ namespace embree
       
       settings.branchingFactor = N;
       settings.maxDepth = BVH::maxBuildDepthLeaf;
-      return BVHBuilderBinnedSAH::build<NodeRef>
-        (FastAllocator::Create(allocator),typename BVH::AABBNode::Create2(),typename BVH::AABBNode::Set3(allocator,prims),createLeafFunc,progressFunc,prims,pinfo,settings);
+      FineBinningStatistics fineBinning;
+      settings.fineBinningStatistics = &fineBinning;
+      BuildRecursionTimer timer(statistics);
+      const NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>
+        (FastAllocator::Create(allocator),timer.nodes(typename BVH::AABBNode::Create2()),typename BVH::AABBNode::Set3(allocator,prims),timer.leaves(createLeafFunc),progressFunc,prims,pinfo,settings);
+      statistics.addFineBinning(fineBinning.numSplits,fineBinning.sahDefault,fineBinning.sahSaved,expectedApproxHalfArea(pinfo.geomBounds));
+      return root;
     }
 
 
     template<int N>
-    typename BVHN<N>::NodeRef BVHNBuilderQuantizedVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings)
+    typename BVHN<N>::NodeRef BVHNBuilderQuantizedVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, BuildStatistics& statistics)
     {
       auto createLeafFunc = [&] (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) -> NodeRef {
         return createLeaf(prims,set,alloc);
@@ -30,8 +46,13 @@ namespace embree
             
       settings.branchingFactor = N;
       settings.maxDepth = BVH::maxBuildDepthLeaf;
-      return BVHBuilderBinnedSAH::build<NodeRef>
-        (FastAllocator::Create(allocator),typename BVH::QuantizedNode::Create2(),typename BVH::QuantizedNode::Set2(),createLeafFunc,progressFunc,prims,pinfo,settings);
+      FineBinningStatistics fineBinning;
+      settings.fineBinningStatistics = &fineBinning;
+      BuildRecursionTimer timer(statistics);
+      const NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>
+        (FastAllocator::Create(allocator),timer.nodes(typename BVH::QuantizedNode::Create2()),typename BVH::QuantizedNode::Set2(),timer.leaves(createLeafFunc),progressFunc,prims,pinfo,settings);
+      statistics.addFineBinning(fineBinning.numSplits,fineBinning.sahDefault,fineBinning.sahSaved,expectedApproxHalfArea(pinfo.geomBounds));
+      return root;
     }
 
     template<int N>
@@ -1,6 +1,8 @@
 // Copyright 2009-2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#pragma once
+
 #include "bvh.h"
 #include "../builders/bvh_builder_sah.h"
 #include "../builders/bvh_builder_msmblur.h"
@@ -9,6 +11,9 @@ namespace embree
 {
   namespace isa
   {
+    /*! returns the minimal subtree size that SAH builds of some quality bin coarse-to-fine */
+    size_t fineBinningThreshold(const Device* device, RTCBuildQuality quality);
+
     /************************************************************************************/
     /************************************************************************************/
     /************************************************************************************/
@@ -22,7 +27,7 @@ namespace embree
         typedef FastAllocator::CachedAllocator Allocator;
       
         struct BVHNBuilderV {
-          NodeRef build(FastAllocator* allocator, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings);
+          NodeRef build(FastAllocator* allocator, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, BuildStatistics& statistics);
           virtual NodeRef createLeaf (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) = 0;
         };
 
@@ -41,8 +46,8 @@ namespace embree
         };
 
         template<typename CreateLeafFunc>
-        static NodeRef build(FastAllocator* allocator, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings) {
-          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(allocator,progress,prims,pinfo,settings);
+        static NodeRef build(FastAllocator* allocator, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, BuildStatistics& statistics) {
+          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(allocator,progress,prims,pinfo,settings,statistics);
         }
       };
 
@@ -54,7 +59,7 @@ namespace embree
         typedef FastAllocator::CachedAllocator Allocator;
       
         struct BVHNBuilderV {
-          NodeRef build(FastAllocator* allocator, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings);
+          NodeRef build(FastAllocator* allocator, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, BuildStatistics& statistics);
           virtual NodeRef createLeaf (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) = 0;
         };
 
@@ -73,8 +78,8 @@ namespace embree
         };
 
         template<typename CreateLeafFunc>
-        static NodeRef build(FastAllocator* allocator, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings) {
-          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(allocator,progress,prims,pinfo,settings);
+        static NodeRef build(FastAllocator* allocator, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, BuildStatistics& statistics) {
+          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(allocator,progress,prims,pinfo,settings,statistics);
         }
       };
 
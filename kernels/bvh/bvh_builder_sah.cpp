@@ -3,6 +3,8 @@
 
 #include "bvh.h"
 #include "bvh_builder.h"
+#include "bvh_optimizer.h"
+#include "bvh_builder_streaming.h"
 #include "../builders/primrefgen.h"
 #include "../builders/splitter.h"
 
@@ -83,6 +85,75 @@ namespace embree
     /************************************************************************************/
     /************************************************************************************/
 
+    __forceinline uint64_t hashCombine(uint64_t h, uint64_t v) {
+      return h ^ (v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+    }
+
+    /*! hashes the first elementBytes of each element of a buffer in parallel */
+    static uint64_t hashBufferView(uint64_t h, const RawBufferView& view, size_t elementBytes)
+    {
+      const size_t blockSize = 4096;
+      const size_t numBlocks = (view.size()+blockSize-1)/blockSize;
+      std::vector<uint64_t> blockHashes(numBlocks);
+      parallel_for(size_t(0), numBlocks, [&](const range<size_t>& r) {
+        for (size_t b=r.begin(); b<r.end(); b++)
+        {
+          uint64_t hb = 0xcbf29ce484222325ull;
+          const size_t end = min(view.size(),(b+1)*blockSize);
+          for (size_t i=b*blockSize; i<end; i++) {
+            const char* element = view.getPtr(i);
+            for (size_t j=0; j+4<=elementBytes; j+=4) {
+              uint32_t v; memcpy(&v,element+j,4);
+              hb = (hb ^ v) * 0x100000001b3ull;
+            }
+          }
+          blockHashes[b] = hb;
+        }
+      });
+      h = hashCombine(h,view.size());
+      for (size_t b=0; b<numBlocks; b++)
+        h = hashCombine(h,blockHashes[b]);
+      return h;
+    }
+
+    /*! calculates the key of a cached BVH from the build settings and all triangle and quad data of the scene */
+    static uint64_t accelCacheKey(Scene* scene, Geometry::GTypeMask gtype, const std::string& name, const GeneralBVHBuilder::Settings& settings, size_t optimizePasses)
+    {
+      uint64_t h = 0xcbf29ce484222325ull;
+      for (size_t i=0; i<name.size(); i++)
+        h = (h ^ uint64_t(name[i])) * 0x100000001b3ull;
+
+      h = hashCombine(h,settings.branchingFactor);
+      h = hashCombine(h,settings.maxDepth);
+      h = hashCombine(h,settings.logBlockSize);
+      h = hashCombine(h,settings.minLeafSize);
+      h = hashCombine(h,settings.maxLeafSize);
+      h = hashCombine(h,uint64_t(1000.0f*settings.travCost));
+      h = hashCombine(h,uint64_t(1000.0f*settings.intCost));
+      h = hashCombine(h,settings.fineBinningThreshold);
+      h = hashCombine(h,optimizePasses);
+      
+      for (size_t geomID=0; geomID<scene->size(); geomID++)
+      {
+        Geometry* geom = scene->get(geomID);
+        if (geom == nullptr || !geom->isEnabled() || geom->numTimeSteps != 1 || !(geom->getTypeMask() & gtype))
+          continue;
+
+        h = hashCombine(h,geomID);
+        if (geom->getTypeMask() == Geometry::MTY_TRIANGLE_MESH) {
+          TriangleMesh* mesh = (TriangleMesh*) geom;
+          h = hashBufferView(h,mesh->triangles,sizeof(TriangleMesh::Triangle));
+          h = hashBufferView(h,mesh->vertices0,sizeof(Vec3f));
+        }
+        else if (geom->getTypeMask() == Geometry::MTY_QUAD_MESH) {
+          QuadMesh* mesh = (QuadMesh*) geom;
+          h = hashBufferView(h,mesh->quads,sizeof(QuadMesh::Quad));
+          h = hashBufferView(h,mesh->vertices0,sizeof(Vec3f));
+        }
+      }
+      return h;
+    }
+
     template<int N, typename Primitive>
     struct BVHNBuilderSAH : public Builder
     {
@@ -130,6 +201,28 @@ namespace embree
         }
 
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
+        const size_t optimizePasses = BVHNOptimizer<N>::passes(bvh->device,mesh ? mesh->quality : scene->getBuildQuality());
+        settings.fineBinningThreshold = fineBinningThreshold(bvh->device,mesh ? mesh->quality : scene->getBuildQuality());
+
+        /* static triangle and quad BVHs can get loaded from the cache directory */
+        const bool useCache = scene && scene->isStaticAccel() && !scene->device->accel_cache_dir.empty() &&
+          (gtype_ == TriangleMesh::geom_type || gtype_ == QuadMesh::geom_type);
+
+        FileName cacheFileName;
+        uint64_t cacheKey = 0;
+        if (useCache)
+        {
+          cacheKey = accelCacheKey(scene,gtype_,TOSTRING(isa) "::BVH" + toString(N) + "<" + bvh->primTy->name() + ">",settings,optimizePasses);
+          std::stringstream name; name << "bvh" << N << "_" << std::hex << cacheKey << ".bvh";
+          cacheFileName = FileName(scene->device->accel_cache_dir) + name.str();
+          if (bvh->loadCache(cacheFileName,cacheKey))
+          {
+            prims.clear();
+            bvh->cleanup();
+            bvh->postBuild(t0);
+            return;
+          }
+        }
 
 #if PROFILE
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
@@ -151,11 +244,30 @@ namespace embree
             const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
             bvh->alloc.init_estimate(node_bytes+leaf_bytes);
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
-            prims.resize(numPrimitives);
 
-            PrimInfo pinfo = mesh ?
-              createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
-              createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            /* static scenes whose primref array exceeds the memory budget get built from chunks of primrefs */
+            const size_t budget = bvh->device->build_memory_budget;
+            const bool streaming = scene && scene->isStaticAccel() && budget != 0 && numPrimitives*sizeof(PrimRef) > budget;
+
+            PrimInfo pinfo(empty);
+            NodeRef root = BVH::emptyNode;
+            if (streaming) {
+              BVHNBuilderStreaming<N> builder(bvh,scene,gtype_,budget);
+              root = builder.build(CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,settings,pinfo);
+            }
+            else
+            {
+              BuildPhaseTimer primrefTimer(bvh->buildStatistics,BuildStatistics::PRIMREF_GENERATION);
+              prims.resize(numPrimitives);
+              pinfo = mesh ?
+                createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
+                createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+              primrefTimer.stop(numPrimitives*sizeof(PrimRef));
+
+              /* call BVH builder */
+              if (pinfo.size() != 0)
+                root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings,bvh->buildStatistics);
+            }
 
             /* pinfo might has zero size due to invalid geometry */
             if (unlikely(pinfo.size() == 0))
@@ -165,9 +277,8 @@ namespace embree
               return;
             }
 
-            /* call BVH builder */
-            NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+            BVHNOptimizer<N>::optimize(bvh,optimizePasses);
             bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
 #if PROFILE
@@ -183,6 +294,12 @@ namespace embree
           prims.clear();
         }
 	bvh->cleanup();
+
+        /* store BVH such that the next run can skip the build */
+        if (useCache && !bvh->saveCache(cacheFileName,cacheKey) && bvh->device->verbosity(1)) {
+          Lock<MutexSys> lock(g_printMutex);
+          std::cout << "cannot write BVH cache file " << cacheFileName << std::endl;
+        }
         bvh->postBuild(t0);
       }
 
@@ -236,15 +353,26 @@ namespace embree
         }
 
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::QBVH" + toString(N) + "BuilderSAH");
+        settings.fineBinningThreshold = fineBinningThreshold(bvh->device,mesh ? mesh->quality : scene->getBuildQuality());
 
 #if PROFILE
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
             /* create primref array */
+            BuildPhaseTimer primrefTimer(bvh->buildStatistics,BuildStatistics::PRIMREF_GENERATION);
             prims.resize(numPrimitives);
             PrimInfo pinfo = mesh ?
               createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
 	      createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            primrefTimer.stop(numPrimitives*sizeof(PrimRef));
+
+            /* pinfo might has zero size due to invalid geometry */
+            if (unlikely(pinfo.size() == 0))
+            {
+              bvh->clear();
+              prims.clear();
+              return;
+            }
 
             /* enable os_malloc for two level build */
             if (mesh)
@@ -255,7 +383,7 @@ namespace embree
             const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
             bvh->alloc.init_estimate(node_bytes+leaf_bytes);
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
-            NodeRef root = BVHNBuilderQuantizedVirtual<N>::build(&bvh->alloc,CreateLeafQuantized<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            NodeRef root = BVHNBuilderQuantizedVirtual<N>::build(&bvh->alloc,CreateLeafQuantized<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings,bvh->buildStatistics);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
             //bvh->layoutLargeNodes(pinfo.size()*0.005f); // FIXME: COPY LAYOUT FOR LARGE NODES !!!
 #if PROFILE
@@ -392,6 +520,7 @@ namespace embree
         }
 
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
+        settings.fineBinningThreshold = fineBinningThreshold(bvh->device,mesh ? mesh->quality : scene->getBuildQuality());
 
         /* create primref array */
         settings.primrefarrayalloc = numPrimitives/1000;
@@ -419,7 +548,7 @@ namespace embree
         }
 
         /* call BVH builder */
-        NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafGrid<N,SubGridQBVHN<N>>(bvh,sgrids.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+        NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafGrid<N,SubGridQBVHN<N>>(bvh,sgrids.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings,bvh->buildStatistics);
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
@@ -532,6 +661,9 @@ namespace embree
     Builder* BVH8InstanceMeshBuilderSAH (void* bvh, Instance* mesh, Geometry::GTypeMask gtype, unsigned int geomID, size_t mode) {
       return new BVHNBuilderSAH<8,InstancePrimitive>((BVH8*)bvh,mesh,geomID,8,1.0f,1,1,gtype);
     }
+    Builder* BVH8QuantizedInstanceSceneBuilderSAH (void* bvh, Scene* scene, Geometry::GTypeMask gtype) {
+      return new BVHNBuilderSAHQuantized<8,InstancePrimitive>((BVH8*)bvh,scene,8,1.0f,1,1,gtype);
+    }
 #endif
 #endif
 
@@ -549,6 +681,9 @@ namespace embree
     Builder* BVH8InstanceArrayMeshBuilderSAH (void* bvh, InstanceArray* mesh, Geometry::GTypeMask gtype, unsigned int geomID, size_t mode) {
       return new BVHNBuilderSAH<8,InstanceArrayPrimitive>((BVH8*)bvh,mesh,geomID,8,1.0f,1,1,gtype);
     }
+    Builder* BVH8QuantizedInstanceArraySceneBuilderSAH (void* bvh, Scene* scene, Geometry::GTypeMask gtype) {
+      return new BVHNBuilderSAHQuantized<8,InstanceArrayPrimitive>((BVH8*)bvh,scene,8,1.0f,1,1,gtype);
+    }
 #endif
 #endif
 
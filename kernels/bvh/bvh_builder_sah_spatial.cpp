@@ -3,6 +3,7 @@
 
 #include "bvh.h"
 #include "bvh_builder.h"
+#include "bvh_optimizer.h"
 
 #include "../builders/primrefgen.h"
 #include "../builders/primrefgen_presplit.h"
@@ -92,6 +93,7 @@ namespace embree
         const unsigned int maxGeomID = mesh ? geomID_ : scene->getMaxGeomID<Mesh,false>();
         const bool usePreSplits = scene->device->useSpatialPreSplits || (maxGeomID >= ((unsigned int)1 << (32-RESERVED_NUM_SPATIAL_SPLITS_GEOMID_BITS)));
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + (usePreSplits ? "BuilderFastSpatialPresplitSAH" : "BuilderFastSpatialSAH"));
+        settings.fineBinningThreshold = fineBinningThreshold(bvh->device,mesh ? mesh->quality : scene->getBuildQuality());
 
         /* create primref array */
         const size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
@@ -109,8 +111,8 @@ namespace embree
 	  {		     
             /* spatial presplit SAH BVH builder */
 	    pinfo = mesh ?
-	      createPrimRefArray_presplit<Mesh,Splitter>(mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface) :
-	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface);
+	      createPrimRefArray_presplit<Mesh,Splitter>(mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface,bvh->buildStatistics) :
+	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface,bvh->buildStatistics);
 
 	    const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AABBNode)/(4*N);
 	    const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
@@ -121,14 +123,16 @@ namespace embree
 	    settings.maxDepth = BVH::maxBuildDepthLeaf;
 
 	    /* call BVH builder */
-	    root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafSpatial<N,Primitive>(bvh),bvh->scene->progressInterface,prims0.data(),pinfo,settings);
+	    root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafSpatial<N,Primitive>(bvh),bvh->scene->progressInterface,prims0.data(),pinfo,settings,bvh->buildStatistics);
 	  }
 	else
 	  {
             /* standard spatial split SAH BVH builder */
+            BuildPhaseTimer primrefTimer(bvh->buildStatistics,BuildStatistics::PRIMREF_GENERATION);
 	    pinfo = mesh ?
 	      createPrimRefArray(mesh,geomID_,numSplitPrimitives,prims0,bvh->scene->progressInterface) :
 	      createPrimRefArray(scene,Mesh::geom_type,false,numSplitPrimitives,prims0,bvh->scene->progressInterface);
+            primrefTimer.stop(prims0.size()*sizeof(PrimRef));
 	
 	    Splitter splitter(scene);
 
@@ -141,21 +145,26 @@ namespace embree
 	    settings.maxDepth = BVH::maxBuildDepthLeaf;
 
 	    /* call BVH builder */
+            FineBinningStatistics fineBinning;
+            settings.fineBinningStatistics = &fineBinning;
+            BuildRecursionTimer timer(bvh->buildStatistics);
 	    root = BVHBuilderBinnedFastSpatialSAH::build<NodeRef>(
 								  typename BVH::CreateAlloc(bvh),
-								  typename BVH::AABBNode::Create2(),
+								  timer.nodes(typename BVH::AABBNode::Create2()),
 								  typename BVH::AABBNode::Set2(),
-								  CreateLeafSpatial<N,Primitive>(bvh),
+								  timer.leaves(CreateLeafSpatial<N,Primitive>(bvh)),
 								  splitter,
 								  bvh->scene->progressInterface,
 								  prims0.data(),
 								  numSplitPrimitives,
 								  pinfo,settings);
+            bvh->buildStatistics.addFineBinning(fineBinning.numSplits,fineBinning.sahDefault,fineBinning.sahSaved,expectedApproxHalfArea(pinfo.geomBounds));
 
 	    /* ==================== */
 	  }
 
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        BVHNOptimizer<N>::optimize(bvh,BVHNOptimizer<N>::passes(bvh->device,mesh ? mesh->quality : scene->getBuildQuality()));
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
 	/* clear temporary data for static geometry */
@@ -0,0 +1,216 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh_builder.h"
+#include "../builders/primrefgen.h"
+#include "../builders/bvh_builder_morton.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Builds a BVH over scenes whose primref array would exceed the
+     *  build memory budget of the device. Primrefs are generated in
+     *  chunks from the geometry buffers multiple times instead of being
+     *  stored. The primitives are partitioned into spatial clusters
+     *  along a coarse Morton curve, such that the primrefs of each
+     *  cluster fit into the budget, a BVH is built for each cluster,
+     *  and these BVHs get combined by a top-level SAH build. */
+    template<int N>
+      struct BVHNBuilderStreaming
+      {
+        typedef BVHN<N> BVH;
+        typedef typename BVH::NodeRef NodeRef;
+        typedef FastAllocator::CachedAllocator Allocator;
+        typedef BVHBuilderMorton::MortonCodeMapping MortonCodeMapping;
+
+        static const size_t CELL_BITS_PER_DIM = 6;                          //!< Morton cells are the finest granularity of clusters
+        static const size_t NUM_CELLS = size_t(1) << (3*CELL_BITS_PER_DIM);
+        static const size_t BLOCK_SIZE = 4096;                             //!< primrefs per task when gathering clusters
+
+        struct Cluster
+        {
+          size_t cellBegin;
+          size_t cellEnd;
+          size_t numPrimitives;
+        };
+
+        BVHNBuilderStreaming (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype, size_t memoryBudget)
+          : bvh(bvh), scene(scene), gtype(gtype), mapping(BBox3fa(empty)), chunk(scene->device,0)
+        {
+          /* a quarter of the budget holds the chunk, the remaining memory the primrefs of one cluster */
+          chunkSize   = max(memoryBudget/(4*sizeof(PrimRef)),BLOCK_SIZE);
+          clusterSize = max(3*memoryBudget/(4*sizeof(PrimRef)),BLOCK_SIZE);
+        }
+
+        /*! calls func for the primrefs of each chunk of the scene and returns the merged bounds */
+        template<typename Func>
+        PrimInfo streamPrimRefs(const Func& func)
+        {
+          chunk.resize(chunkSize);
+          PrimInfo pinfo(empty);
+          Scene::Iterator2 iter(scene,gtype,false);
+          for (size_t geomID=0; geomID<iter.size(); geomID++)
+          {
+            Geometry* geom = iter[geomID];
+            if (geom == nullptr) continue;
+            for (size_t begin=0; begin<geom->size(); begin+=chunkSize)
+            {
+              const range<size_t> r(begin,min(begin+chunkSize,geom->size()));
+              const PrimInfo cinfo = createPrimRefArray(geom,(unsigned)geomID,r,chunk);
+              if (cinfo.size() == 0) continue;
+              func(chunk.data(),cinfo.size());
+              pinfo.merge(cinfo);
+            }
+          }
+          return pinfo;
+        }
+
+        __forceinline size_t cell(const PrimRef& prim) const {
+          return mapping.code(prim.bounds()) >> (3*(MortonCodeMapping::LATTICE_BITS_PER_DIM-CELL_BITS_PER_DIM));
+        }
+
+        /*! partitions the Morton cells into consecutive clusters with at most clusterSize primitives */
+        void createClusters(const PrimInfo& pinfo)
+        {
+          mapping = MortonCodeMapping(pinfo.centBounds);
+
+          std::unique_ptr<std::atomic<size_t>[]> counts(new std::atomic<size_t>[NUM_CELLS]);
+          for (size_t i=0; i<NUM_CELLS; i++) counts[i] = 0;
+
+          streamPrimRefs([&] (const PrimRef* prims, size_t num) {
+            parallel_for(size_t(0), num, BLOCK_SIZE, [&](const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+                counts[cell(prims[i])]++;
+            });
+          });
+
+          /* cells denser than the cluster size end up in a cluster of their own */
+          clusters.clear();
+          Cluster cluster = { 0, 0, 0 };
+          for (size_t i=0; i<NUM_CELLS; i++)
+          {
+            const size_t count = counts[i];
+            if (cluster.numPrimitives > 0 && cluster.numPrimitives+count > clusterSize) {
+              clusters.push_back(cluster);
+              cluster = { i, i, 0 };
+            }
+            cluster.cellEnd = i+1;
+            cluster.numPrimitives += count;
+          }
+          if (cluster.numPrimitives > 0)
+            clusters.push_back(cluster);
+        }
+
+        /*! copies the primrefs of the chunk that fall into the cluster to dst in order, and returns their number */
+        size_t gatherCluster(const Cluster& cluster, const PrimRef* prims, size_t num, PrimRef* dst)
+        {
+          const size_t numBlocks = (num+BLOCK_SIZE-1)/BLOCK_SIZE;
+          std::vector<size_t> offsets(numBlocks+1,0);
+          parallel_for(size_t(0), numBlocks, [&](const range<size_t>& r) {
+            for (size_t b=r.begin(); b<r.end(); b++) {
+              size_t n = 0;
+              for (size_t i=b*BLOCK_SIZE; i<min(num,(b+1)*BLOCK_SIZE); i++) {
+                const size_t c = cell(prims[i]);
+                n += c >= cluster.cellBegin && c < cluster.cellEnd;
+              }
+              offsets[b+1] = n;
+            }
+          });
+          for (size_t b=0; b<numBlocks; b++)
+            offsets[b+1] += offsets[b];
+
+          parallel_for(size_t(0), numBlocks, [&](const range<size_t>& r) {
+            for (size_t b=r.begin(); b<r.end(); b++) {
+              size_t k = offsets[b];
+              for (size_t i=b*BLOCK_SIZE; i<min(num,(b+1)*BLOCK_SIZE); i++) {
+                const size_t c = cell(prims[i]);
+                if (c >= cluster.cellBegin && c < cluster.cellEnd) dst[k++] = prims[i];
+              }
+            }
+          });
+          return offsets[numBlocks];
+        }
+
+        /*! builds the BVH and returns its root, pinfo returns the bounds of all primitives */
+        template<typename CreateLeafFunc>
+        NodeRef build(CreateLeafFunc createLeaf, BuildProgressMonitor& progress, const GeneralBVHBuilder::Settings& settings, PrimInfo& pinfo)
+        {
+          /* first pass calculates bounds, second pass the clusters */
+          BuildPhaseTimer boundsTimer(bvh->buildStatistics,BuildStatistics::PRIMREF_GENERATION);
+          pinfo = streamPrimRefs([] (const PrimRef* prims, size_t num) {});
+          if (pinfo.size() == 0) return BVH::emptyNode;
+          createClusters(pinfo);
+          boundsTimer.stop(chunk.size()*sizeof(PrimRef));
+
+          /* build one BVH per cluster, each requiring one pass over all primitives */
+          size_t maxClusterSize = 0;
+          for (const Cluster& cluster : clusters)
+            maxClusterSize = max(maxClusterSize,cluster.numPrimitives);
+
+          mvector<PrimRef> prims(scene->device,maxClusterSize);
+          mvector<PrimRef> roots(scene->device,clusters.size());
+          PrimInfo rinfo(empty);
+          for (size_t i=0; i<clusters.size(); i++)
+          {
+            BuildPhaseTimer gatherTimer(bvh->buildStatistics,BuildStatistics::PRIMREF_GENERATION);
+            size_t num = 0;
+            streamPrimRefs([&] (const PrimRef* chunkPrims, size_t numChunkPrims) {
+              num += gatherCluster(clusters[i],chunkPrims,numChunkPrims,prims.data()+num);
+            });
+            assert(num == clusters[i].numPrimitives);
+            gatherTimer.stop(i == 0 ? prims.size()*sizeof(PrimRef) : 0);
+
+            const PrimInfo cinfo = parallel_reduce(size_t(0), num, size_t(1024), PrimInfo(empty), [&] (const range<size_t>& r) -> PrimInfo {
+              PrimInfo info(empty);
+              for (size_t j=r.begin(); j<r.end(); j++) info.add_center2(prims[j]);
+              return info;
+            }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
+
+            const NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,createLeaf,progress,prims.data(),cinfo,settings,bvh->buildStatistics);
+            roots[i] = PrimRef(cinfo.geomBounds,(size_t)root);
+            rinfo.add_center2(roots[i]);
+          }
+          prims.clear();
+
+          if (roots.size() == 1)
+            return (NodeRef) roots[0].ID();
+
+          /* combine the cluster BVHs */
+          BuildPhaseTimer mergeTimer(bvh->buildStatistics,BuildStatistics::TWO_LEVEL_MERGE);
+          GeneralBVHBuilder::Settings topSettings;
+          topSettings.branchingFactor = N;
+          topSettings.maxDepth = BVH::maxBuildDepthLeaf;
+          topSettings.logBlockSize = bsr(N);
+          topSettings.minLeafSize = 1;
+          topSettings.maxLeafSize = 1;
+          topSettings.travCost = 1.0f;
+          topSettings.intCost = 1.0f;
+          topSettings.singleThreadThreshold = settings.singleThreadThreshold;
+
+          return BVHBuilderBinnedSAH::build<NodeRef>(
+            typename BVH::CreateAlloc(bvh),
+            typename BVH::AABBNode::Create2(),
+            typename BVH::AABBNode::Set2(),
+            [&] (const PrimRef* refs, const range<size_t>& range, const Allocator& alloc) -> NodeRef {
+              assert(range.size() == 1);
+              return (NodeRef) refs[range.begin()].ID();
+            },
+            [&] (size_t dn) { bvh->scene->progressMonitor(0); },
+            roots.data(),rinfo,topSettings);
+        }
+
+      public:
+        BVH* bvh;
+        Scene* scene;
+        Geometry::GTypeMask gtype;
+        MortonCodeMapping mapping;
+        mvector<PrimRef> chunk;
+        size_t chunkSize;                //!< maximal number of primrefs generated at once
+        size_t clusterSize;              //!< targeted maximal number of primrefs of a cluster
+        std::vector<Cluster> clusters;
+      };
+  }
+}
@@ -12,6 +12,8 @@
 #include "../common/scene_triangle_mesh.h"
 #include "../common/scene_quad_mesh.h"
 
+#include <unordered_map>
+
 #define PROFILE 0
 
 namespace embree
@@ -48,12 +50,17 @@ namespace embree
       while(1) 
 #endif
       {
+      const size_t numPrimitives = scene->getNumPrimitives(gtype,false);
+
+      /* try to only update modified objects in previous top-level BVH */
+      if (updateTopLevel(numPrimitives))
+        return;
+      topLevelValid = false;
+
       /* reset memory allocator */
       bvh->alloc.reset();
       
       /* skip build for empty scene */
-      const size_t numPrimitives = scene->getNumPrimitives(gtype,false);
-
       if (numPrimitives == 0) {
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
@@ -93,6 +100,10 @@ namespace embree
         }
       });
 
+      /* objects that do not get rebuilt should not contribute to the build statistics */
+      for (size_t objectID=0; objectID<num; objectID++)
+        if (bvh->objects[objectID]) bvh->objects[objectID]->buildStatistics.reset();
+
       /* parallel build of acceleration structures */
       parallel_for(size_t(0), num, [&] (const range<size_t>& r)
       {
@@ -107,6 +118,11 @@ namespace embree
         }
       });
 
+      for (size_t objectID=0; objectID<num; objectID++)
+        if (bvh->objects[objectID]) bvh->buildStatistics.accumulatePhases(bvh->objects[objectID]->buildStatistics);
+
+      BuildPhaseTimer mergeTimer(bvh->buildStatistics,BuildStatistics::TWO_LEVEL_MERGE);
+
 
 #if PROFILE
       double d0 = getSeconds();
@@ -178,6 +194,8 @@ namespace embree
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             
             refs.resize(extSize); 
+            topLeaves.resize(extSize);
+            numTopLeaves.store(0);
          
             NodeRef root = BVHBuilderBinnedOpenMergeSAH::build<NodeRef,BuildRef>(
               typename BVH::CreateAlloc(bvh),
@@ -186,13 +204,17 @@ namespace embree
               
               [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
                 assert(range.size() == 1);
-                return (NodeRef) refs[range.begin()].node;
+                const BuildRef& ref = refs[range.begin()];
+                topLeaves[numTopLeaves++] = { ref.node, ref.geomID() };
+                return (NodeRef) ref.node;
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
                 return openBuildRef(bref,refs);
               },              
               [&] (size_t dn) { bvh->scene->progressMonitor(0); },
               refs.data(),extSize,pinfo,settings);
+
+            recordTopLevel(root);
 #else
             NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>(
               typename BVH::CreateAlloc(bvh),
@@ -214,6 +236,7 @@ namespace embree
       }  
         
       bvh->alloc.cleanup();
+      mergeTimer.stop(bvh->alloc.getUsedBytes());
       bvh->postBuild(t0);
 #if PROFILE
       double d1 = getSeconds();
@@ -223,9 +246,132 @@ namespace embree
 
     }
     
+    template<int N, typename Mesh, typename Primitive>
+    bool BVHNBuilderTwoLevel<N,Mesh,Primitive>::updateTopLevel(size_t numPrimitives)
+    {
+      if (!topLevelValid || objectTypes.size() != scene->size())
+        return false;
+
+      /* find modified objects, anything else than modified large objects requires a full rebuild */
+      std::vector<size_t> modified;
+      for (size_t objectID=0; objectID<objectTypes.size(); objectID++)
+      {
+        const char type = objectType(objectID);
+        if (type != objectTypes[objectID]) return false;
+        if (type == 0 || !isGeometryModified(objectID)) continue;
+        if (type == 1 || builders[objectID]->meshQualityChanged(getMesh(objectID)->quality)) return false;
+
+        /* an object that was empty during the last full build has no slot to get inserted into */
+        if (objectSlots[objectID] == objectSlots[objectID+1]) return false;
+        modified.push_back(objectID);
+      }
+
+      /* the top-level BVH degrades with each update, thus rebuild it regularly */
+      numUpdatedObjects += modified.size();
+      if (numUpdatedObjects*MAX_INCREMENTAL_UPDATE_FRACTION > numLargeObjects)
+        return false;
+
+      double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderTwoLevelUpdate");
+
+      /* rebuild modified objects */
+      parallel_for(size_t(0), modified.size(), [&] (const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            assert(dynamic_cast<RefBuilderLarge*>(builders[modified[i]].get()));
+            ((RefBuilderLarge*)builders[modified[i]].get())->build();
+          }
+        });
+
+      for (size_t objectID : modified)
+        bvh->buildStatistics.accumulatePhases(getBVH(objectID)->buildStatistics);
+
+      BuildPhaseTimer mergeTimer(bvh->buildStatistics,BuildStatistics::TWO_LEVEL_MERGE);
+
+      /* the first slot of each modified object now references the new object root, all
+       * other slots of that object become empty, bounds are refitted up to the root */
+      for (size_t objectID : modified)
+      {
+        BVH* object = getBVH(objectID);
+        const BBox3fa bounds = object->getBounds();
+        for (size_t i=objectSlots[objectID]; i<objectSlots[objectID+1]; i++)
+        {
+          const TopLevelSlot& slot = topSlots[i];
+          AABBNode* node = topNodes[slot.node].node;
+          if (i == objectSlots[objectID] && !bounds.empty())
+            node->set(slot.slot,object->root,bounds);
+          else
+            node->set(slot.slot,BVH::emptyNode,empty);
+
+          for (int n = slot.node; topNodes[n].parent >= 0; n = topNodes[n].parent)
+            topNodes[topNodes[n].parent].node->setBounds(topNodes[n].slot,topNodes[n].node->bounds());
+        }
+      }
+
+      bvh->set(bvh->root,LBBox3fa(topNodes[0].node->bounds()),numPrimitives);
+      mergeTimer.stop();
+      bvh->postBuild(t0);
+      return true;
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::recordTopLevel(NodeRef root)
+    {
+      topNodes.clear();
+      topSlots.clear();
+      numUpdatedObjects = 0;
+      if (!root.isAABBNode())
+        return;
+
+      std::unordered_map<size_t,unsigned int> leaves;
+      leaves.reserve(numTopLeaves);
+      for (size_t i=0; i<numTopLeaves; i++)
+        leaves[(size_t)topLeaves[i].node] = topLeaves[i].geomID;
+
+      /* all nodes that are not top-level leaves were created by the top-level build */
+      std::vector<TopLevelNode> stack;
+      stack.push_back({ root.getAABBNode(), -1, 0 });
+      while (!stack.empty())
+      {
+        const TopLevelNode cur = stack.back(); stack.pop_back();
+        const unsigned int index = (unsigned int) topNodes.size();
+        topNodes.push_back(cur);
+
+        for (unsigned int c=0; c<N; c++)
+        {
+          NodeRef child = cur.node->child(c);
+          if (child == BVH::emptyNode) continue;
+
+          auto leaf = leaves.find((size_t)child);
+          if (leaf != leaves.end())
+            topSlots.push_back({ leaf->second, index, c });
+          else if (child.isAABBNode())
+            stack.push_back({ child.getAABBNode(), (int)index, c });
+          else
+            return;
+        }
+      }
+      std::sort(topSlots.begin(),topSlots.end());
+
+      /* calculate slot range of each object */
+      const size_t num = scene->size();
+      objectSlots.assign(num+1,0);
+      for (const TopLevelSlot& slot : topSlots)
+        objectSlots[slot.geomID+1]++;
+      for (size_t i=0; i<num; i++)
+        objectSlots[i+1] += objectSlots[i];
+
+      objectTypes.resize(num);
+      numLargeObjects = 0;
+      for (size_t objectID=0; objectID<num; objectID++) {
+        objectTypes[objectID] = objectType(objectID);
+        numLargeObjects += objectTypes[objectID] == 2;
+      }
+      topLevelValid = true;
+    }
+
     template<int N, typename Mesh, typename Primitive>
     void BVHNBuilderTwoLevel<N,Mesh,Primitive>::deleteGeometry(size_t geomID)
     {
+      topLevelValid = false;
       if (geomID >= bvh->objects.size()) return;
       if (builders[geomID]) builders[geomID].reset();
       delete bvh->objects [geomID]; bvh->objects [geomID] = nullptr;
@@ -234,6 +380,8 @@ namespace embree
     template<int N, typename Mesh, typename Primitive>
     void BVHNBuilderTwoLevel<N,Mesh,Primitive>::clear()
     {
+      topLevelValid = false;
+
       for (size_t i=0; i<bvh->objects.size(); i++) 
         if (bvh->objects[i]) bvh->objects[i]->clear();
 
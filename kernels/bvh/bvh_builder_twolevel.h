@@ -17,6 +17,9 @@
 #define SPLIT_MEMORY_RESERVE_SCALE 2
 #define SPLIT_MIN_EXT_SPACE 1000
 
+/* incremental top-level update */
+#define MAX_INCREMENTAL_UPDATE_FRACTION 8 // rebuild top-level BVH once 1/8th of all large objects got updated incrementally
+
 namespace embree
 {
   namespace isa
@@ -116,6 +119,20 @@ namespace embree
       
     private:
 
+      /*! updates the previous top-level BVH in place if only some large objects got modified, returns false if a full rebuild is required */
+      bool updateTopLevel(size_t numPrimitives);
+
+      /*! records top-level nodes and the slots referencing objects after a full top-level build */
+      void recordTopLevel(NodeRef root);
+
+      /*! classifies objects for the incremental update: 0 = not in BVH, 1 = small, 2 = large */
+      char objectType(size_t objectID)
+      {
+        Mesh* mesh = scene->getSafe<Mesh>(objectID);
+        if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) return 0;
+        return isSmallGeometry(mesh) ? 1 : 2;
+      }
+
       class RefBuilderBase {
       public:
         virtual ~RefBuilderBase () {}
@@ -192,6 +209,11 @@ namespace embree
           return currQuality != quality_;
         }
 
+        /*! rebuilds the object BVH without creating build primitives */
+        void build () {
+          builder_->build();
+        }
+
       private:
         size_t          objectID_;
         Ref<Builder>    builder_;
@@ -248,6 +270,33 @@ namespace embree
 
       using BuilderList = std::vector<std::unique_ptr<RefBuilderBase>>;
 
+      /*! leaf of the top-level BVH, references a small object block or a (possibly opened) subtree of a large object */
+      struct TopLevelLeaf
+      {
+        NodeRef node;
+        unsigned int geomID;
+      };
+
+      /*! node of the top-level BVH */
+      struct TopLevelNode
+      {
+        AABBNode* node;
+        int parent;          //!< index of the parent node, -1 for the root
+        unsigned int slot;   //!< child slot in the parent node
+      };
+
+      /*! child slot of a top-level node that references a top-level leaf */
+      struct TopLevelSlot
+      {
+        unsigned int geomID;
+        unsigned int node;   //!< index of the top-level node
+        unsigned int slot;   //!< child slot in that node
+
+        friend bool operator< (const TopLevelSlot& a, const TopLevelSlot& b) {
+          return a.geomID < b.geomID;
+        }
+      };
+
       BuilderList         builders;
       BVH*                bvh;
       Scene*              scene;      
@@ -257,6 +306,17 @@ namespace embree
       const size_t        singleThreadThreshold;
       Geometry::GTypeMask gtype;
       bool                useMortonBuilder_ = false;
+
+      /* state of the last full top-level build used for incremental updates */
+      std::vector<TopLevelLeaf> topLeaves;
+      std::atomic<size_t>       numTopLeaves;
+      std::vector<TopLevelNode> topNodes;
+      std::vector<TopLevelSlot> topSlots;         //!< slots sorted by geomID
+      std::vector<size_t>       objectSlots;      //!< range of slots of each object in topSlots
+      std::vector<char>         objectTypes;      //!< object classification at last full build
+      size_t                    numLargeObjects = 0;
+      size_t                    numUpdatedObjects = 0; //!< number of incremental object updates since last full build
+      bool                      topLevelValid = false;
     };
   }
 }
@@ -67,6 +67,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* gather traversal statistics if the query is sampled */
+      TraversalCounters counters(context->stats);
+
       /* pop loop */
       while (true) pop:
       {
@@ -87,6 +90,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          counters.nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -100,6 +104,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        counters.leaves++; counters.primitives += num;
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
         tray.tfar = ray.tfar;
@@ -153,6 +158,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* gather traversal statistics if the query is sampled */
+      TraversalCounters counters(context->stats);
+
       /* pop loop */
       while (true) pop:
       {
@@ -169,6 +177,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          counters.nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -182,6 +191,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        counters.leaves++; counters.primitives += num;
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
           ray.tfar = neg_inf;
@@ -44,6 +44,9 @@ namespace embree
                                                                                                 const TravRayK<K, robust>& tray,
                                                                                                 RayQueryContext* context)
     {
+      /* gather traversal statistics if the query is sampled */
+      TraversalCounters counters(context->stats);
+
       /* stack state */
       StackItemT<NodeRef> stack[stackSizeSingle];  // stack of nodes
       StackItemT<NodeRef>* stackPtr = stack + 1;   // current stack pointer
@@ -75,6 +78,7 @@ namespace embree
           STAT3(normal.trav_nodes, 1, 1, 1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          counters.nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -88,6 +92,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves, 1, 1, 1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        counters.leaves++; counters.primitives += num;
 
         size_t lazy_node = 0;
         PrimitiveIntersectorK::intersect(This, pre, ray, k, context, prim, num, tray1, lazy_node);
@@ -108,6 +113,9 @@ namespace embree
                                                                                                RayHitK<K>& __restrict__ ray,
                                                                                                RayQueryContext* __restrict__ context)
     {
+      /* gather traversal statistics if the query is sampled */
+      TraversalCounters counters(context->stats);
+
       BVH* __restrict__ bvh = (BVH*)This->ptr;
       
       /* we may traverse an empty BVH in case all geometry was invalid */
@@ -255,6 +263,7 @@ namespace embree
             /* process nodes */
             const vbool<K> valid_node = tray.tfar > curDist;
             STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            counters.nodes++;
             const NodeRef nodeRef = cur;
             const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -356,6 +365,7 @@ namespace embree
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          counters.leaves++; counters.primitives += items;
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(valid_leaf, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -376,6 +386,9 @@ namespace embree
                                                                                                        RayHitK<K>& __restrict__ ray,
                                                                                                        RayQueryContext* context)
     {
+      /* gather traversal statistics if the query is sampled */
+      TraversalCounters counters(context->stats);
+
       BVH* __restrict__ bvh = (BVH*)This->ptr;
       
       /* filter out invalid rays */
@@ -455,6 +468,7 @@ namespace embree
               vfloat<K> lnearP;
               vbool<K> lhit = false; // motion blur is not supported, so the initial value will be ignored
               STAT3(normal.trav_nodes, 1, 1, 1);
+              counters.nodes++;
               BVHNNodeIntersectorK<N, K, types, robust>::intersect(nodeRef, i, tray, ray.time(), lnearP, lhit);
 
               if (likely(any(lhit)))
@@ -507,6 +521,7 @@ namespace embree
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          counters.leaves++; counters.primitives += items;
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(valid_leaf, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -542,6 +557,9 @@ namespace embree
                                                                                                const TravRayK<K, robust>& tray,
                                                                                                RayQueryContext* context)
       {
+        /* gather traversal statistics if the query is sampled */
+        TraversalCounters counters(context->stats);
+
         /* stack state */
         NodeRef stack[stackSizeSingle];  // stack of nodes that still need to get traversed
         NodeRef* stackPtr = stack+1;     // current stack pointer
@@ -568,6 +586,7 @@ namespace embree
             STAT3(shadow.trav_nodes, 1, 1, 1);
             bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
             if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+            counters.nodes++;
 
             /* if no child is hit, pop next node */
             if (unlikely(mask == 0))
@@ -581,6 +600,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
           STAT3(shadow.trav_leaves, 1, 1, 1);
           size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          counters.leaves++; counters.primitives += num;
 
           size_t lazy_node = 0;
           if (PrimitiveIntersectorK::occluded(This, pre, ray, k, context, prim, num, tray1, lazy_node)) {
@@ -602,6 +622,9 @@ namespace embree
                                                                                               RayK<K>& __restrict__ ray,
                                                                                               RayQueryContext* context)
     {
+      /* gather traversal statistics if the query is sampled */
+      TraversalCounters counters(context->stats);
+
       BVH* __restrict__ bvh = (BVH*)This->ptr;
       
       /* we may traverse an empty BVH in case all geometry was invalid */
@@ -704,6 +727,7 @@ namespace embree
           /* process nodes */
           const vbool<K> valid_node = tray.tfar > curDist;
           STAT3(shadow.trav_nodes, 1, popcnt(valid_node), K);
+          counters.nodes++;
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -765,6 +789,7 @@ namespace embree
         STAT3(shadow.trav_leaves, 1, popcnt(valid_leaf), K);
         if (unlikely(none(valid_leaf))) continue;
         size_t items; const Primitive* prim = (Primitive*) cur.leaf(items);
+        counters.leaves++; counters.primitives += items;
 
         size_t lazy_node = 0;
         terminated |= PrimitiveIntersectorK::occluded(!terminated, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -787,6 +812,9 @@ namespace embree
                                                                                                       RayK<K>& __restrict__ ray,
                                                                                                       RayQueryContext* context)
     {
+      /* gather traversal statistics if the query is sampled */
+      TraversalCounters counters(context->stats);
+
       BVH* __restrict__ bvh = (BVH*)This->ptr;
       
       /* filter out invalid rays */
@@ -873,6 +901,7 @@ namespace embree
               vfloat<K> lnearP;
               vbool<K> lhit = false; // motion blur is not supported, so the initial value will be ignored
               STAT3(normal.trav_nodes, 1, 1, 1);
+              counters.nodes++;
               BVHNNodeIntersectorK<N, K, types, robust>::intersect(nodeRef, i, tray, ray.time(), lnearP, lhit);
 
               if (likely(any(lhit)))
@@ -902,6 +931,7 @@ namespace embree
 #endif
           if (unlikely(!m_active)) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          counters.leaves++; counters.primitives += items;
 
           size_t lazy_node = 0;
           terminated |= PrimitiveIntersectorK::occluded(!terminated, This, pre, ray, context, prim, items, tray, lazy_node);
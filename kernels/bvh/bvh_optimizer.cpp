@@ -0,0 +1,233 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh_optimizer.h"
+#include "bvh_statistics.h"
+
+#include "../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int N>
+    size_t BVHNOptimizer<N>::passes(const Device* device, RTCBuildQuality quality)
+    {
+      if (device->bvh_optimize_passes >= 0)
+        return device->bvh_optimize_passes;
+
+      return quality == RTC_BUILD_QUALITY_HIGH ? 2 : 0;
+    }
+
+    template<int N>
+    void BVHNOptimizer<N>::optimize(BVH* bvh, size_t passes)
+    {
+      bvh->optimizeTime = 0.0;
+      bvh->optimizeSAHBefore = bvh->optimizeSAHAfter = 0.0;
+      if (passes == 0 || !bvh->root.isAABBNode())
+        return;
+
+      const double t0 = getSeconds();
+      bvh->optimizeSAHBefore = BVHNStatistics<N>(bvh).sah();
+
+      for (size_t i=0; i<passes; i++) {
+        size_t heights[N];
+        recurse(bvh->root,0,heights);
+      }
+
+      bvh->optimizeSAHAfter = BVHNStatistics<N>(bvh).sah();
+      bvh->optimizeTime = getSeconds()-t0;
+    }
+
+    template<int N>
+    size_t BVHNOptimizer<N>::recurse(NodeRef ref, size_t depth, size_t heights[N])
+    {
+      /* leaves are never changed, other node types are treated like leaves that cannot get pushed down */
+      if (!ref.isAABBNode())
+        return ref.isLeaf() ? 0 : BVH::maxBuildDepthLeaf;
+
+      AABBNode* node = ref.getAABBNode();
+      size_t childHeights[N][N];
+
+      if (depth < PARALLEL_DEPTH_THRESHOLD) {
+        parallel_for(size_t(N), [&] (size_t i) {
+            heights[i] = recurse(node->child(i),depth+1,childHeights[i]);
+          });
+      }
+      else {
+        for (size_t i=0; i<N; i++)
+          heights[i] = recurse(node->child(i),depth+1,childHeights[i]);
+      }
+
+      restructure(node,depth,heights,childHeights);
+
+      size_t height = 0;
+      for (size_t i=0; i<N; i++)
+        height = max(height,heights[i]);
+      return 1+height;
+    }
+
+    template<int N>
+    void BVHNOptimizer<N>::restructure(AABBNode* node, size_t depth, size_t heights[N], size_t childHeights[N][N])
+    {
+      /* gather grandchildren and leaf children of the node, inner children are the nodes we can reuse */
+      Item items[MAX_TREELET_ITEMS];
+      bool canDescend[MAX_TREELET_ITEMS];
+      NodeRef inner[N];
+      size_t numItems = 0, numInner = 0;
+      float cost = 0.0f;
+
+      for (size_t c=0; c<N; c++)
+      {
+        const NodeRef child = node->child(c);
+        if (child == BVH::emptyNode) continue;
+
+        if (child.isAABBNode())
+        {
+          const AABBNode* n = child.getAABBNode();
+          inner[numInner++] = child;
+          cost += halfArea(node->bounds(c));
+          for (size_t i=0; i<N; i++) {
+            if (n->child(i) == BVH::emptyNode) continue;
+            items[numItems] = { n->child(i), n->bounds(i), childHeights[c][i] };
+            canDescend[numItems++] = true;
+          }
+        }
+        else
+        {
+          /* leaf children may only get pushed one level down if the depth limit permits */
+          items[numItems] = { child, node->bounds(c), heights[c] };
+          canDescend[numItems++] = depth+2+heights[c] <= BVH::maxBuildDepthLeaf;
+        }
+      }
+      if (numInner == 0)
+        return;
+
+      /* each item starts as its own cluster, clusters with more than one item get an inner node */
+      struct Cluster
+      {
+        BBox3fa bounds;
+        float cost;
+        size_t num;
+        bool canDescend;
+        unsigned char items[N];
+      };
+      Cluster clusters[MAX_TREELET_ITEMS];
+      size_t numClusters = numItems;
+      for (size_t i=0; i<numItems; i++) {
+        clusters[i].bounds = items[i].bounds;
+        clusters[i].cost = 0.0f;
+        clusters[i].num = 1;
+        clusters[i].canDescend = canDescend[i];
+        clusters[i].items[0] = (unsigned char) i;
+      }
+
+      /* cost change when merging two clusters */
+      auto mergeCost = [&] (size_t a, size_t b) -> float
+      {
+        const Cluster& ca = clusters[a];
+        const Cluster& cb = clusters[b];
+        if (ca.num+cb.num > N || !ca.canDescend || !cb.canDescend) return float(pos_inf);
+        return halfArea(merge(ca.bounds,cb.bounds)) - ca.cost - cb.cost;
+      };
+
+      /* best merge partner for each cluster */
+      float bestCost[MAX_TREELET_ITEMS];
+      size_t bestPartner[MAX_TREELET_ITEMS];
+      auto findPartner = [&] (size_t a)
+      {
+        bestCost[a] = float(pos_inf); bestPartner[a] = a;
+        for (size_t b=0; b<numClusters; b++) {
+          if (b == a) continue;
+          const float c = mergeCost(a,b);
+          if (c < bestCost[a]) { bestCost[a] = c; bestPartner[a] = b; }
+        }
+      };
+      for (size_t a=0; a<numClusters; a++)
+        findPartner(a);
+
+      /* greedily merge clusters until they fit into the node and no merge reduces cost anymore */
+      while (numClusters > 1)
+      {
+        size_t a = 0;
+        for (size_t i=1; i<numClusters; i++)
+          if (bestCost[i] < bestCost[a]) a = i;
+
+        if (bestCost[a] == float(pos_inf)) break;
+        if (numClusters <= N && bestCost[a] >= 0.0f) break;
+
+        /* merge cluster b into a and move last cluster to b */
+        size_t b = bestPartner[a];
+        if (b < a) std::swap(a,b);
+        Cluster& ca = clusters[a];
+        const Cluster& cb = clusters[b];
+        ca.bounds = merge(ca.bounds,cb.bounds);
+        ca.cost = halfArea(ca.bounds);
+        for (size_t i=0; i<cb.num; i++) ca.items[ca.num++] = cb.items[i];
+
+        const size_t last = --numClusters;
+        if (b != last) {
+          clusters[b] = clusters[last];
+          bestCost[b] = bestCost[last];
+          bestPartner[b] = bestPartner[last];
+        }
+
+        /* update merge partners */
+        for (size_t i=0; i<numClusters; i++)
+        {
+          if (bestPartner[i] == last) bestPartner[i] = b;
+          if (i == a || bestPartner[i] == a || bestPartner[i] == b) findPartner(i);
+          else {
+            const float c = mergeCost(i,a);
+            if (c < bestCost[i]) { bestCost[i] = c; bestPartner[i] = a; }
+          }
+        }
+      }
+
+      /* only accept the new treelet if it fits into the existing nodes and lowers the cost */
+      if (numClusters > N) return;
+
+      float newCost = 0.0f;
+      size_t numNewInner = 0;
+      for (size_t k=0; k<numClusters; k++) {
+        if (clusters[k].num == 1) continue;
+        newCost += clusters[k].cost;
+        numNewInner++;
+      }
+      if (numNewInner > numInner || !(newCost < (1.0f-1E-4f)*cost))
+        return;
+
+      /* rewrite the treelet, inner nodes not needed anymore stay unreferenced in the allocator */
+      node->clear();
+      for (size_t k=0, next=0; k<numClusters; k++)
+      {
+        const Cluster& cluster = clusters[k];
+        if (cluster.num == 1) {
+          const Item& item = items[cluster.items[0]];
+          node->set(k,item.ref,item.bounds);
+          heights[k] = item.height;
+          continue;
+        }
+
+        AABBNode* n = inner[next].getAABBNode();
+        n->clear();
+        size_t height = 0;
+        for (size_t i=0; i<cluster.num; i++) {
+          const Item& item = items[cluster.items[i]];
+          n->set(i,item.ref,item.bounds);
+          height = max(height,item.height);
+        }
+        node->set(k,inner[next++],cluster.bounds);
+        heights[k] = 1+height;
+      }
+      for (size_t k=numClusters; k<N; k++)
+        heights[k] = 0;
+    }
+
+    template class BVHNOptimizer<4>;
+
+#if defined(__AVX__)
+    template class BVHNOptimizer<8>;
+#endif
+  }
+}
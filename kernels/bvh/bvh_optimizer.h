@@ -0,0 +1,51 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Post-build optimization of static BVHs. Each pass visits all
+     *  nodes bottom-up and redistributes the grandchildren of a node
+     *  among its inner children (the treelet of the node) such that
+     *  the summed surface area of these inner children is minimal. */
+    template<int N>
+    class BVHNOptimizer
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::AABBNode AABBNode;
+      typedef typename BVH::NodeRef NodeRef;
+
+      static const size_t MAX_TREELET_ITEMS = N*N;
+      static const size_t PARALLEL_DEPTH_THRESHOLD = 3;
+
+      /*! subtree that gets redistributed inside a treelet */
+      struct Item
+      {
+        NodeRef ref;
+        BBox3fa bounds;
+        size_t height;
+      };
+
+    public:
+
+      /*! returns the number of optimization passes for a build of some quality */
+      static size_t passes(const Device* device, RTCBuildQuality quality);
+
+      /*! optimizes the BVH in the specified number of passes */
+      static void optimize(BVH* bvh, size_t passes);
+
+    private:
+
+      /*! optimizes all treelets of a subtree bottom-up, returns the height of the subtree */
+      static size_t recurse(NodeRef ref, size_t depth, size_t heights[N]);
+
+      /*! restructures the treelet of a node */
+      static void restructure(AABBNode* node, size_t depth, size_t heights[N], size_t childHeights[N][N]);
+    };
+  }
+}
@@ -31,33 +31,145 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0), tablesValid(false)
     {
     }
 
     template<int N>
     void BVHNRefitter<N>::refit()
     {
+      const double t0 = getSeconds();
+      size_t numNodes = 0, numLeaves = 0;
+      
       if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD) {
-        bvh->bounds = LBBox3fa(recurse_bottom(bvh->root));
+        bvh->bounds = LBBox3fa(recurse_bottom(bvh->root,numNodes,numLeaves));
       }
       else
       {
         BBox3fa subTreeBounds[MAX_NUM_SUB_TREES];
         numSubTrees = 0;
         gather_subtree_refs(bvh->root,numSubTrees,0);
+        std::atomic<size_t> subTreeNodes(0), subTreeLeaves(0);
         if (numSubTrees)
           parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
+              size_t nodes = 0, leaves = 0;
               for (size_t i=r.begin(); i<r.end(); i++) {
                 NodeRef& ref = subTrees[i];
-                subTreeBounds[i] = recurse_bottom(ref);
+                subTreeBounds[i] = recurse_bottom(ref,nodes,leaves);
               }
+              subTreeNodes += nodes; subTreeLeaves += leaves;
             });
 
         numSubTrees = 0;        
         bvh->bounds = LBBox3fa(refit_toplevel(bvh->root,numSubTrees,subTreeBounds,0));
-      }    
-  }
+        numNodes = subTreeNodes + numSubTrees; numLeaves = subTreeLeaves;
+      }
+
+      bvh->refitTime = getSeconds()-t0;
+      bvh->numRefitNodes = numNodes;
+      bvh->numRefitLeaves = numLeaves;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::reset()
+    {
+      tablesValid = false;
+      nodes.clear(); nodes.shrink_to_fit();
+      leaves.clear(); leaves.shrink_to_fit();
+      pending.reset();
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::gather_tables()
+    {
+      nodes.clear();
+      leaves.clear();
+
+      std::vector<std::pair<NodeRef,RefitNode>> stack;
+      stack.push_back(std::make_pair(bvh->root,RefitNode { nullptr, -1, 0 }));
+      while (!stack.empty())
+      {
+        NodeRef ref = stack.back().first;
+        RefitNode cur = stack.back().second;
+        stack.pop_back();
+        cur.node = ref.getAABBNode();
+        const unsigned int index = (unsigned int) nodes.size();
+        nodes.push_back(cur);
+
+        for (unsigned int i=0; i<N; i++)
+        {
+          NodeRef& child = cur.node->child(i);
+          if (unlikely(child == BVH::emptyNode)) continue;
+          if (child.isAABBNode()) stack.push_back(std::make_pair(child,RefitNode { nullptr, (int)index, i }));
+          else                    leaves.push_back(RefitLeaf { index, i, leafBounds.leafVertexRange(child) });
+        }
+      }
+
+      pending.reset(new std::atomic<unsigned int>[nodes.size()]);
+      for (size_t i=0; i<nodes.size(); i++) pending[i] = 0;
+      tablesValid = true;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::refit(size_t begin, size_t end)
+    {
+      /* the tables require the BVH to consist of AABB nodes */
+      if (!bvh->root.isAABBNode()) {
+        refit();
+        return;
+      }
+
+      const double t0 = getSeconds();
+      if (!tablesValid) gather_tables();
+
+      /* find dirty leaves */
+      std::vector<unsigned int> dirty;
+      for (size_t i=0; i<leaves.size(); i++) {
+        const range<size_t>& r = leaves[i].vertices;
+        if (r.begin() < end && begin < r.end()) dirty.push_back((unsigned int)i);
+      }
+
+      /* count dirty children of each node, each newly dirty node counts once in its parent */
+      size_t numDirtyNodes = 0;
+      for (size_t i=0; i<dirty.size(); i++)
+      {
+        int n = leaves[dirty[i]].parent;
+        while (pending[n]++ == 0) {
+          numDirtyNodes++;
+          if (nodes[n].parent < 0) break;
+          n = nodes[n].parent;
+        }
+      }
+
+      /* refit dirty leaves and continue with the parent once its last dirty child is done */
+      auto refitLeaf = [&] (const RefitLeaf& leaf)
+      {
+        AABBNode* parent = nodes[leaf.parent].node;
+        parent->setBounds(leaf.slot,leafBounds.leafBounds(parent->child(leaf.slot)));
+
+        for (int n = leaf.parent; pending[n]-- == 1; n = nodes[n].parent)
+        {
+          if (nodes[n].parent < 0) break;
+          nodes[nodes[n].parent].node->setBounds(nodes[n].slot,nodes[n].node->bounds());
+        }
+      };
+
+      if (dirty.size() <= SINGLE_THREAD_THRESHOLD/4) {
+        for (size_t i=0; i<dirty.size(); i++)
+          refitLeaf(leaves[dirty[i]]);
+      }
+      else {
+        parallel_for(size_t(0), dirty.size(), size_t(64), [&](const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++)
+              refitLeaf(leaves[dirty[i]]);
+          });
+      }
+
+      bvh->bounds = LBBox3fa(nodes[0].node->bounds());
+      bvh->refitTime = getSeconds()-t0;
+      bvh->numRefitNodes = numDirtyNodes;
+      bvh->numRefitLeaves = dirty.size();
+    }
 
     template<int N>
     void BVHNRefitter<N>::gather_subtree_refs(NodeRef& ref,
@@ -132,14 +244,17 @@ namespace embree
 
     
     template<int N>
-    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref)
+    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref, size_t& numNodes, size_t& numLeaves)
     {
       /* this is a leaf node */
-      if (unlikely(ref.isLeaf()))
+      if (unlikely(ref.isLeaf())) {
+        numLeaves++;
         return leafBounds.leafBounds(ref);
+      }
       
       /* recurse if this is an internal node */
       AABBNode* node = ref.getAABBNode();
+      numNodes++;
 
       /* enable exclusive prefetch for >= AVX platforms */      
 #if defined(__AVX__)      
@@ -153,7 +268,7 @@ namespace embree
           bounds[i] = BBox3fa(empty);          
         }
       else
-        bounds[i] = recurse_bottom(node->child(i));
+        bounds[i] = recurse_bottom(node->child(i),numNodes,numLeaves);
       
       /* AOS to SOA transform */
       BBox3vf<N> boundsT = transpose<N>(bounds);
@@ -171,11 +286,12 @@ namespace embree
 
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
-      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0) {}
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0), vertexModCounter(0) {}
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
     {
+      refitter->reset();
       if (builder) 
         builder->clear();
     }
@@ -183,12 +299,21 @@ namespace embree
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::build()
     {
+      size_t begin, end;
       if (mesh->topologyChanged(topologyVersion)) {
         topologyVersion = mesh->getTopologyVersion();
         builder->build();
+        refitter->reset();
       }
       else
-        refitter->refit();
+      {
+        if (RefitVertexRange<Mesh,Primitive>::modifiedRange(mesh,vertexModCounter,begin,end))
+          refitter->refit(begin,end);
+        else
+          refitter->refit();
+      }
+
+      vertexModCounter = RefitVertexRange<Mesh,Primitive>::modCounter(mesh);
     }
 
     template class BVHNRefitter<4>;
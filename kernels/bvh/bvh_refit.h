@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../bvh/bvh.h"
+#include "../common/scene_triangle_mesh.h"
+#include "../common/scene_quad_mesh.h"
 
 namespace embree
 {
@@ -21,6 +23,25 @@ namespace embree
 
       struct LeafBoundsInterface {
         virtual const BBox3fa leafBounds(NodeRef& ref) const = 0;
+
+        /*! range of vertices referenced by a leaf, leaves without vertex range are refitted by each dirty range refit */
+        virtual const range<size_t> leafVertexRange(NodeRef& ref) const { return range<size_t>(0,-1); }
+      };
+
+      /*! inner node with parent link used by the dirty range refit */
+      struct RefitNode
+      {
+        AABBNode* node;
+        int parent;                //!< index of parent node, -1 for the root
+        unsigned int slot;         //!< child slot in parent node
+      };
+
+      /*! leaf with parent link and referenced vertex range used by the dirty range refit */
+      struct RefitLeaf
+      {
+        unsigned int parent;       //!< index of parent node
+        unsigned int slot;         //!< child slot in parent node
+        range<size_t> vertices;    //!< referenced vertex range
       };
 
     public:
@@ -31,7 +52,16 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! refits only leaves that reference vertices in [begin,end) and their parent chains */
+      void refit(size_t begin, size_t end);
+
+      /*! invalidates the node and leaf tables of the dirty range refit, has to get called when the BVH got rebuilt */
+      void reset();
+
     private:
+      /* gathers the node and leaf tables for the dirty range refit */
+      void gather_tables();
+
       /* single-threaded subtree extraction based on BVH depth */
       void gather_subtree_refs(NodeRef& ref, 
                                size_t &subtrees,
@@ -44,7 +74,7 @@ namespace embree
                              const size_t depth = 0);
 
       /* single-threaded subtree refit */
-      BBox3fa recurse_bottom(NodeRef& ref);
+      BBox3fa recurse_bottom(NodeRef& ref, size_t& numNodes, size_t& numLeaves);
       
     public:
       BVH* bvh;                              //!< BVH to refit
@@ -54,8 +84,68 @@ namespace embree
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
       size_t numSubTrees;
       NodeRef subTrees[MAX_NUM_SUB_TREES];
+
+      /* tables for the dirty range refit, gathered on first use after a build */
+      bool tablesValid;
+      std::vector<RefitNode> nodes;
+      std::vector<RefitLeaf> leaves;
+      std::unique_ptr<std::atomic<unsigned int>[]> pending; //!< number of dirty children per node not yet refitted
+    };
+
+    /*! provides vertex ranges for the dirty range refit, geometries without vertex buffers always get refitted entirely */
+    template<typename Mesh, typename Primitive>
+    struct RefitVertexRange
+    {
+      static bool modifiedRange(const Mesh* mesh, unsigned int modCounter, size_t& begin, size_t& end) { return false; }
+      static unsigned int modCounter(const Mesh* mesh) { return 0; }
+      static range<size_t> leafVertexRange(const Mesh* mesh, const Primitive* prims, size_t num) { return range<size_t>(0,-1); }
+    };
+
+    __forceinline void extendVertexRange(const TriangleMesh* mesh, unsigned int primID, size_t& lower, size_t& upper)
+    {
+      const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+      for (size_t k=0; k<3; k++) {
+        lower = min(lower,size_t(tri.v[k]));
+        upper = max(upper,size_t(tri.v[k])+1);
+      }
+    }
+
+    __forceinline void extendVertexRange(const QuadMesh* mesh, unsigned int primID, size_t& lower, size_t& upper)
+    {
+      const QuadMesh::Quad& quad = mesh->quad(primID);
+      for (size_t k=0; k<4; k++) {
+        lower = min(lower,size_t(quad.v[k]));
+        upper = max(upper,size_t(quad.v[k])+1);
+      }
+    }
+
+    template<typename Mesh, typename Primitive>
+    struct RefitVertexRangeMesh
+    {
+      static bool modifiedRange(const Mesh* mesh, unsigned int modCounter, size_t& begin, size_t& end) {
+        return mesh->numTimeSteps == 1 && mesh->vertices[0].getModifiedRange(modCounter,begin,end);
+      }
+
+      static unsigned int modCounter(const Mesh* mesh) {
+        return mesh->vertices[0].getModCounter();
+      }
+
+      static range<size_t> leafVertexRange(const Mesh* mesh, const Primitive* prims, size_t num)
+      {
+        size_t lower = -1, upper = 0;
+        for (size_t i=0; i<num; i++) {
+          for (size_t j=0; j<Primitive::max_size(); j++) {
+            if (!prims[i].valid(j)) break;
+            extendVertexRange(mesh,prims[i].primID(j),lower,upper);
+          }
+        }
+        return range<size_t>(lower,upper);
+      }
     };
 
+    template<typename Primitive> struct RefitVertexRange<TriangleMesh,Primitive> : public RefitVertexRangeMesh<TriangleMesh,Primitive> {};
+    template<typename Primitive> struct RefitVertexRange<QuadMesh,Primitive>     : public RefitVertexRangeMesh<QuadMesh,Primitive> {};
+
     template<int N, typename Mesh, typename Primitive>
     class BVHNRefitT : public Builder, public BVHNRefitter<N>::LeafBoundsInterface
     {
@@ -83,6 +173,12 @@ namespace embree
             bounds.extend(((Primitive*)prim)[i].update(mesh));
         return bounds;
       }
+
+      virtual const range<size_t> leafVertexRange (NodeRef& ref) const
+      {
+        size_t num; char* prim = ref.leaf(num);
+        return RefitVertexRange<Mesh,Primitive>::leafVertexRange(mesh,(Primitive*)prim,num);
+      }
       
     private:
       BVH* bvh;
@@ -90,6 +186,7 @@ namespace embree
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
       unsigned int topologyVersion;
+      unsigned int vertexModCounter;
     };
   }
 }
@@ -33,6 +33,8 @@ namespace embree
     if (stat.statQuantizedNodes.numNodes  ) stream << "  quantizedNodes   : "  << stat.statQuantizedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "  leaves           : "  << stat.statLeaf.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "    histogram      : "  << stat.statLeaf.histToString() << std::endl;
+    if (bvh->optimizeTime > 0.0)            stream << "  optimization     : time = " << std::setw(7) << std::setprecision(3) << 1000.0*bvh->optimizeTime << " ms, sah = " << std::setprecision(3) << bvh->optimizeSAHBefore << " -> " << bvh->optimizeSAHAfter << std::endl;
+    if (bvh->numRefitLeaves)                stream << "  last refit       : time = " << std::setw(7) << std::setprecision(3) << 1000.0*bvh->refitTime << " ms, #nodes = " << bvh->numRefitNodes << ", #leaves = " << bvh->numRefitLeaves << std::endl;
     return stream.str();
   }
   
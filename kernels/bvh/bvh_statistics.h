@@ -272,6 +272,21 @@ namespace embree
       return stat.bytes(bvh);
     }
 
+    /*! SAH cost before the post-build optimization */
+    double optimizeSAHBefore() const {
+      return bvh->optimizeSAHBefore;
+    }
+
+    /*! SAH cost after the post-build optimization */
+    double optimizeSAHAfter() const {
+      return bvh->optimizeSAHAfter;
+    }
+
+    /*! duration of the last refit in seconds */
+    double refitTime() const {
+      return bvh->refitTime;
+    }
+
   private:
     Statistics statistics(NodeRef node, const double A, const BBox1f dt);
 
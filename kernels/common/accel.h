@@ -7,6 +7,7 @@
 #include "ray.h"
 #include "point_query.h"
 #include "context.h"
+#include "build_statistics.h"
 
 namespace embree
 {
@@ -52,6 +53,7 @@ namespace embree
   public:
     LBBox3fa bounds; // linear bounds
     Type type;
+    BuildStatistics buildStatistics; // statistics of the last build
   };
 
   /*! Base class for all intersectable and buildable acceleration structures. */
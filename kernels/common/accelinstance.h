@@ -22,6 +22,7 @@ namespace embree
     void build () {
       if (builder) builder->build();
       bounds = accel->bounds;
+      buildStatistics = accel->buildStatistics;
     }
 
     void deleteGeometry(size_t geomID) {
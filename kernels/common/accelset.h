@@ -19,6 +19,7 @@ namespace embree
     Geometry* geometry;
     RTCScene forward_scene;
     RTCIntersectArguments* args;
+    TraversalStatistics::Counters* stats;
   };
 
   struct OccludedFunctionNArguments : public RTCOccludedFunctionNArguments
@@ -26,6 +27,7 @@ namespace embree
     Geometry* geometry;
     RTCScene forward_scene;
     RTCIntersectArguments* args;
+    TraversalStatistics::Counters* stats;
   };
 
   /*! Base class for set of acceleration structures. */
@@ -158,6 +160,7 @@ namespace embree
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
+        args.stats = context->stats;
 
         IntersectFuncN intersectFunc = nullptr;
         intersectFunc = intersectorN.intersect;
@@ -188,6 +191,7 @@ namespace embree
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
+        args.stats = context->stats;
 
         OccludedFuncN occludedFunc = nullptr;
         occludedFunc = intersectorN.occluded;
@@ -218,6 +222,7 @@ namespace embree
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = nullptr;
+        args.stats = nullptr;
 
         typedef void (*RTCIntersectFunctionSYCL)(const void* args);
         RTCIntersectFunctionSYCL intersectFunc = nullptr;
@@ -255,6 +260,7 @@ namespace embree
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = nullptr;
+        args.stats = nullptr;
 
         typedef void (*RTCOccludedFunctionSYCL)(const void* args);
         RTCOccludedFunctionSYCL occludedFunc = nullptr;
@@ -293,6 +299,7 @@ namespace embree
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
+        args.stats = context->stats;
 
         IntersectFuncN intersectFunc = nullptr;
         intersectFunc = intersectorN.intersect;
@@ -322,6 +329,7 @@ namespace embree
         args.geometry = this;
         args.forward_scene = nullptr;
         args.args = context->args;
+        args.stats = context->stats;
 
         OccludedFuncN occludedFunc = nullptr;
         occludedFunc = intersectorN.occluded;
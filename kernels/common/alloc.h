@@ -173,12 +173,14 @@ namespace embree
                    bool blockAllocation = true)
       : device(device)
       , slotMask(0)
+      , numaNodes((device && device->numa) ? getNumberOfNUMANodes() : 1)
       , defaultBlockSize(PAGE_SIZE)
       , estimatedSize(0)
       , growSize(PAGE_SIZE)
       , maxGrowSize(maxAllocationSize)
       , usedBlocks(nullptr)
       , freeBlocks(nullptr)
+      , arenaBlock(nullptr)
       , useUSM(useUSM)
       , blockAllocation(blockAllocation)
       , use_single_mode(false)
@@ -319,6 +321,7 @@ namespace embree
     static const size_t threadLocalAllocOverhead = 20; //! 20 means 5% parallel allocation overhead through unfilled thread local blocks
     static const size_t mainAllocOverheadStatic  = 20;  //! 20 means 5% allocation overhead through unfilled main alloc blocks
     static const size_t mainAllocOverheadDynamic = 8;  //! 20 means 12.5% allocation overhead through unfilled main alloc blocks
+    static const size_t arenaReserveFactor = 2;        //! arena reserves twice the estimated size of virtual memory
 
     /* calculates a single threaded threshold for the builders such
      * that for small scenes the overhead of partly allocated blocks
@@ -423,6 +426,15 @@ namespace embree
       //initGrowSizeAndNumSlots(bytesEstimate,false);
       initGrowSizeAndNumSlots(bytesEstimate,false);
 
+      /* reserve a single arena for the entire build, pages get committed lazily on first touch */
+      const bool arena = device->alloc_arena || !device->alloc_arena_dir.empty();
+      if (arena && atype == EMBREE_OS_MALLOC && !useUSM && bytesEstimate >= maxAllocationSize)
+      {
+        const size_t bytesReserve = (arenaReserveFactor*bytesEstimate+PAGE_SIZE_2M-1) & ~(PAGE_SIZE_2M-1);
+        usedBlocks = arenaBlock = Block::createArena(device,bytesReserve,nullptr);
+        for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
+          threadUsedBlocks[i] = arenaBlock;
+      }
     }
 
     /*! frees state not required after build */
@@ -433,6 +445,9 @@ namespace embree
       /* unbind all thread local allocators */
       for (auto alloc : thread_local_allocators) alloc->unbind(this);
       thread_local_allocators.clear();
+
+      /* release unused tail pages of the arena */
+      if (arenaBlock) arenaBlock->shrink_block();
     }
 
     /*! resets the allocator, memory blocks get reused */
@@ -476,6 +491,7 @@ namespace embree
       bytesWasted.store(0);
       if (usedBlocks.load() != nullptr) usedBlocks.load()->clear_list(device,useUSM); usedBlocks = nullptr;
       if (freeBlocks.load() != nullptr) freeBlocks.load()->clear_list(device,useUSM); freeBlocks = nullptr;
+      arenaBlock = nullptr;
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++) {
         threadUsedBlocks[i] = nullptr;
         threadBlocks[i] = nullptr;
@@ -489,6 +505,23 @@ namespace embree
       return size_t(1) << min(size_t(16),scale);
     }
 
+    /*! returns the block slot the calling thread allocates from */
+    __forceinline size_t getSlot() const
+    {
+      const size_t threadID = TaskScheduler::threadID();
+      if (likely(numaNodes <= 1))
+        return threadID & slotMask;
+
+      /* partition the slots among the NUMA nodes, such that the blocks
+       * of a slot get first touched by threads of a single node only and
+       * thus get placed in memory of that node */
+      const size_t numSlots = slotMask+1;
+      const size_t node = getCurrentNUMANode();
+      if (numSlots <= numaNodes) return node & slotMask;
+      const size_t slotsPerNode = numSlots/numaNodes;
+      return (node*slotsPerNode + threadID%slotsPerNode) & slotMask;
+    }
+
     /*! thread safe allocation of memory */
     void* malloc(size_t& bytes, size_t align, bool partial)
     {
@@ -497,8 +530,7 @@ namespace embree
       while (true)
       {
         /* allocate using current block */
-        size_t threadID = TaskScheduler::threadID();
-        size_t slot = threadID & slotMask;
+        size_t slot = getSlot();
         Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align,partial);
@@ -558,6 +590,17 @@ namespace embree
       freeBlocks = new (aptr) Block(SHARED,bytes-sizeof_Header,bytes-sizeof_Header,freeBlocks,ofs);
     }
 
+    /*! allocates a single contiguous block that can exceed maxAllocationSize, used to load prebuilt BVH images */
+    void* mallocContiguous(size_t bytes)
+    {
+      Lock<MutexSys> lock(mutex);
+      bytes = (bytes+maxAlignment-1) & ~(maxAlignment-1);
+      usedBlocks = Block::create(device,useUSM,bytes,bytes,usedBlocks,atype);
+      void* ptr = usedBlocks.load()->malloc(device,bytes,maxAlignment,false);
+      bytesUsed += bytes;
+      return ptr;
+    }
+
     /* special allocation only used from morton builder only a single time for each build */
     void* specialAlloc(size_t bytes)
     {
@@ -799,6 +842,19 @@ namespace embree
         return NULL;
       }
 
+      /*! creates a block that reserves a large virtual range but
+       *  only accounts for pages that get used by allocations, the
+       *  range is backed by a temporary file if configured */
+      static Block* createArena(Device* device, size_t bytesReserve, Block* next)
+      {
+        const size_t sizeof_Header = offsetof(Block,data[0]);
+        if (device) device->memoryMonitor(sizeof_Header,false);
+        bool huge_pages = false; void* ptr = nullptr;
+        if (device && !device->alloc_arena_dir.empty()) ptr = os_malloc_file(bytesReserve,device->alloc_arena_dir);
+        else                                             ptr = os_malloc(bytesReserve,huge_pages);
+        return new (ptr) Block(EMBREE_OS_MALLOC,0,bytesReserve-sizeof_Header,next,0,huge_pages);
+      }
+
       Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false)
       : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), huge_pages(huge_pages)
       {
@@ -845,6 +901,15 @@ namespace embree
         }
       }
 
+      /*! releases the reserved but unused pages at the end of an os_malloc block */
+      void shrink_block()
+      {
+        if (atype != EMBREE_OS_MALLOC) return;
+        const size_t sizeof_Header = offsetof(Block,data[0]);
+        const size_t bytesNew = os_shrink(this,sizeof_Header+getBlockAllocatedBytes(),sizeof_Header+reserveEnd,huge_pages);
+        reserveEnd = min(size_t(reserveEnd),bytesNew-sizeof_Header);
+      }
+
       void* malloc(MemoryMonitorInterface* device, size_t& bytes_in, size_t align, bool partial)
       {
         size_t bytes = bytes_in;
@@ -972,6 +1037,7 @@ namespace embree
   private:
     Device* device;
     size_t slotMask;
+    size_t numaNodes;           //!< number of NUMA nodes the block slots are partitioned among
     size_t defaultBlockSize;
     size_t estimatedSize;
     size_t growSize;
@@ -983,6 +1049,7 @@ namespace embree
     std::atomic<Block*> threadBlocks[MAX_THREAD_USED_BLOCK_SLOTS];
     std::atomic<Block*> usedBlocks;
     std::atomic<Block*> freeBlocks;
+    Block* arenaBlock;                        //!< block reserving virtual memory for the entire build
 
     bool useUSM;
     bool blockAllocation = true;
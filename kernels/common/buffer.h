@@ -242,7 +242,8 @@ namespace embree
   public:
     /*! Buffer construction */
     RawBufferView()
-      : ptr_ofs(nullptr), dptr_ofs(nullptr), stride(0), num(0), format(RTC_FORMAT_UNDEFINED), modCounter(1), modified(true), userData(0) {}
+      : ptr_ofs(nullptr), dptr_ofs(nullptr), stride(0), num(0), format(RTC_FORMAT_UNDEFINED), modCounter(1), modified(true),
+        modifiedBegin(0), modifiedEnd(-1), modifiedRangeCounter(0), userData(0) {}
 
   public:
     /*! sets the buffer view */
@@ -271,6 +272,7 @@ namespace embree
       format = format_in;
       modCounter++;
       modified = true;
+      modifiedBegin = 0; modifiedEnd = -1;
       buffer = buffer_in;
     }
 
@@ -332,9 +334,38 @@ namespace embree
     __forceinline void setModified() {
       modCounter++;
       modified = true;
+      modifiedBegin = 0; modifiedEnd = -1;
       if (buffer) buffer->setNeedsCommit();
     }
 
+    /*! marks the items [begin,end) as modified, ranges accumulate until clearModifiedRange is called */
+    __forceinline void setModified(size_t begin, size_t end) {
+      modCounter++;
+      modified = true;
+      modifiedBegin = min(modifiedBegin,begin); modifiedEnd = max(modifiedEnd,end);
+      if (buffer) buffer->setNeedsCommit();
+    }
+
+    /*! returns the modification counter */
+    __forceinline unsigned int getModCounter() const {
+      return modCounter;
+    }
+
+    /*! returns the range of items modified since modification counter otherModCounter, fails if that range is no longer tracked */
+    __forceinline bool getModifiedRange(unsigned int otherModCounter, size_t& begin, size_t& end) const
+    {
+      if (otherModCounter < modifiedRangeCounter) return false;
+      if (otherModCounter >= modCounter) { begin = end = 0; return true; }
+      begin = modifiedBegin; end = min(modifiedEnd,num);
+      return true;
+    }
+
+    /*! starts tracking a new modified range */
+    __forceinline void clearModifiedRange() {
+      modifiedBegin = -1; modifiedEnd = 0;
+      modifiedRangeCounter = modCounter;
+    }
+
     /*! mark buffer as modified or unmodified */
     __forceinline bool isModified(unsigned int otherModCounter) const {
       return modCounter > otherModCounter;
@@ -370,6 +401,9 @@ namespace embree
     RTCFormat format;   //!< format of the buffer
     unsigned int modCounter; //!< version ID of this buffer
     bool modified;      //!< local modified data
+    size_t modifiedBegin;              //!< begin of modified item range
+    size_t modifiedEnd;                //!< end of modified item range
+    unsigned int modifiedRangeCounter; //!< modification counter when tracking of the modified range started
     int userData;       //!< special data
     Ref<Buffer> buffer; //!< reference to the parent buffer
   };
@@ -0,0 +1,251 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "../../common/tasking/taskscheduler.h"
+
+namespace embree
+{
+  /*! Statistics of the last build of an acceleration structure, broken
+   *  down into the phases of the build. */
+  struct BuildStatistics
+  {
+    enum Phase
+    {
+      PRIMREF_GENERATION = 0,
+      PRESPLITS          = 1,
+      BINNING            = 2,
+      NODE_ALLOCATION    = 3,
+      LEAF_CREATION      = 4,
+      TWO_LEVEL_MERGE    = 5,
+      NUM_PHASES         = 6
+    };
+
+    struct PhaseStatistics
+    {
+      PhaseStatistics ()
+        : time(0.0), threadTime(0.0), bytesAllocated(0) {}
+
+      __forceinline PhaseStatistics& operator+= (const PhaseStatistics& other)
+      {
+        time += other.time;
+        threadTime += other.threadTime;
+        bytesAllocated += other.bytesAllocated;
+        return *this;
+      }
+
+    public:
+      double time;            //!< wall clock time the phase was active
+      double threadTime;      //!< time spent by all threads in the phase
+      size_t bytesAllocated;  //!< bytes allocated during the phase
+    };
+
+    BuildStatistics () {
+      reset();
+    }
+
+    void reset()
+    {
+      builder = "";
+      numPrimitives = 0;
+      time = 0.0;
+      bytesAllocated = 0;
+      for (size_t i=0; i<NUM_PHASES; i++)
+        phases[i] = PhaseStatistics();
+      numFineBinningSplits = 0;
+      fineBinningSAHDefault = 0.0;
+      fineBinningSAHSaved = 0.0;
+    }
+
+    /*! accumulates the phases of some other build, used to account the
+     *  per geometry builds of two-level acceleration structures */
+    void accumulatePhases(const BuildStatistics& other)
+    {
+      for (size_t i=0; i<NUM_PHASES; i++)
+        phases[i] += other.phases[i];
+      numFineBinningSplits += other.numFineBinningSplits;
+      fineBinningSAHDefault += other.fineBinningSAHDefault;
+      fineBinningSAHSaved += other.fineBinningSAHSaved;
+    }
+
+    /*! accounts the splits found by coarse-to-fine binning, the split SAH
+     *  costs get normalized by the area of the root bounds */
+    void addFineBinning(size_t numSplits, double sahDefault, double sahSaved, float rootHalfArea)
+    {
+      numFineBinningSplits += numSplits;
+      if (rootHalfArea > 0.0f) {
+        fineBinningSAHDefault += sahDefault/double(rootHalfArea);
+        fineBinningSAHSaved += sahSaved/double(rootHalfArea);
+      }
+    }
+
+  public:
+    std::string builder;                 //!< name of the builder used
+    size_t numPrimitives;                //!< number of primitives built over
+    double time;                         //!< wall clock time of the build
+    size_t bytesAllocated;               //!< bytes used by the acceleration structure
+    PhaseStatistics phases[NUM_PHASES];  //!< statistics per build phase
+    size_t numFineBinningSplits;         //!< number of splits found by coarse-to-fine binning
+    double fineBinningSAHDefault;        //!< split SAH cost of these splits with default binning
+    double fineBinningSAHSaved;          //!< split SAH cost saved by coarse-to-fine binning
+  };
+
+  /*! Measures a build phase executed by the calling thread and the tasks
+   *  it spawns. The thread time is the CPU time the process consumed
+   *  while the phase was active. */
+  class BuildPhaseTimer
+  {
+  public:
+    BuildPhaseTimer (BuildStatistics& stats, BuildStatistics::Phase phase)
+      : stats(stats), phase(phase), active(true), t0(getSeconds()), c0(getProcessCPUSeconds()) {}
+
+    ~BuildPhaseTimer () {
+      stop();
+    }
+
+    void stop(size_t bytesAllocated = 0)
+    {
+      if (!active) return;
+      active = false;
+      stats.phases[phase].time += getSeconds()-t0;
+      stats.phases[phase].threadTime += max(0.0,getProcessCPUSeconds()-c0);
+      stats.phases[phase].bytesAllocated += bytesAllocated;
+    }
+
+  private:
+    BuildStatistics& stats;
+    BuildStatistics::Phase phase;
+    bool active;
+    double t0;
+    double c0;
+  };
+
+  /*! Measures the recursive part of a BVH build, in which binning, node
+   *  allocation and leaf creation are interleaved on all build
+   *  threads. Each invocation of the node and leaf creation closures is
+   *  timed with the cycle counter and accumulated per thread, the
+   *  remaining CPU time of the recursive build is accounted to binning. */
+  class BuildRecursionTimer
+  {
+    enum { NODES = 0, LEAVES = 1 };
+
+    struct ThreadCounters
+    {
+      ThreadCounters () {
+        for (size_t i=0; i<2; i++) { ticks[i] = 0; bytes[i] = 0; }
+      }
+
+      ThreadCounters (const ThreadCounters& other) {
+        for (size_t i=0; i<2; i++) { ticks[i] = other.ticks[i].load(); bytes[i] = other.bytes[i].load(); }
+      }
+
+      std::atomic<uint64_t> ticks[2];
+      std::atomic<size_t> bytes[2];
+      char align[64-2*sizeof(uint64_t)-2*sizeof(size_t)];
+    };
+
+    template<typename Closure, int which>
+    struct Timed
+    {
+      __forceinline Timed (const Closure& closure, BuildRecursionTimer* timer)
+        : closure(closure), timer(timer) {}
+
+      template<typename A0, typename A1, typename Allocator>
+      __forceinline auto operator() (A0&& a0, A1&& a1, const Allocator& alloc) const
+        -> decltype(std::declval<const Closure&>()(std::forward<A0>(a0),std::forward<A1>(a1),alloc))
+      {
+        const size_t b0 = usedBytes(alloc);
+        const uint64_t t0 = read_tsc();
+        auto r = closure(std::forward<A0>(a0),std::forward<A1>(a1),alloc);
+        const size_t b1 = usedBytes(alloc);
+        timer->add(which,read_tsc()-t0,b1 >= b0 ? b1-b0 : b1); // thread local allocator may have been rebound
+        return r;
+      }
+
+    private:
+      Closure closure;
+      BuildRecursionTimer* timer;
+    };
+
+  public:
+    BuildRecursionTimer (BuildStatistics& stats)
+      : stats(stats), counters(2*TaskScheduler::threadCount()), active(true),
+        t0(getSeconds()), c0(getProcessCPUSeconds()), tsc0(read_tsc()) {}
+
+    ~BuildRecursionTimer () {
+      stop();
+    }
+
+    /*! wraps the node creation closure of the builder */
+    template<typename Closure>
+    __forceinline Timed<Closure,NODES> nodes(const Closure& closure) {
+      return Timed<Closure,NODES>(closure,this);
+    }
+
+    /*! wraps the leaf creation closure of the builder */
+    template<typename Closure>
+    __forceinline Timed<Closure,LEAVES> leaves(const Closure& closure) {
+      return Timed<Closure,LEAVES>(closure,this);
+    }
+
+    void stop()
+    {
+      if (!active) return;
+      active = false;
+
+      const double dt = getSeconds()-t0;
+      const double dc = max(0.0,getProcessCPUSeconds()-c0);
+      const uint64_t dtsc = read_tsc()-tsc0;
+      const double secondsPerTick = dtsc ? dt/double(dtsc) : 0.0;
+
+      double threadTime[2] = { 0.0, 0.0 };
+      size_t bytes[2] = { 0, 0 };
+      for (const ThreadCounters& c : counters) {
+        for (size_t i=0; i<2; i++) {
+          threadTime[i] += secondsPerTick*double(c.ticks[i].load());
+          bytes[i] += c.bytes[i].load();
+        }
+      }
+
+      BuildStatistics::PhaseStatistics& binning = stats.phases[BuildStatistics::BINNING];
+      BuildStatistics::PhaseStatistics& nodes   = stats.phases[BuildStatistics::NODE_ALLOCATION];
+      BuildStatistics::PhaseStatistics& leaves  = stats.phases[BuildStatistics::LEAF_CREATION];
+      binning.time += dt;
+      binning.threadTime += max(0.0,dc-threadTime[NODES]-threadTime[LEAVES]);
+      nodes.time += dt;
+      nodes.threadTime += threadTime[NODES];
+      nodes.bytesAllocated += bytes[NODES];
+      leaves.time += dt;
+      leaves.threadTime += threadTime[LEAVES];
+      leaves.bytesAllocated += bytes[LEAVES];
+    }
+
+  private:
+
+    template<typename Allocator>
+    __forceinline static size_t usedBytes(const Allocator& alloc)
+    {
+      if (!alloc) return 0;
+      size_t bytes = alloc.talloc0->getUsedBytes();
+      if (alloc.talloc1 != alloc.talloc0) bytes += alloc.talloc1->getUsedBytes();
+      return bytes;
+    }
+
+    __forceinline void add(size_t which, uint64_t ticks, size_t bytes)
+    {
+      ThreadCounters& c = counters[TaskScheduler::threadIndex() % counters.size()];
+      c.ticks[which].fetch_add(ticks,std::memory_order_relaxed);
+      c.bytes[which].fetch_add(bytes,std::memory_order_relaxed);
+    }
+
+  private:
+    BuildStatistics& stats;
+    std::vector<ThreadCounters> counters;
+    bool active;
+    double t0;
+    double c0;
+    uint64_t tsc0;
+  };
+}
@@ -6,6 +6,7 @@
 #include "default.h"
 #include "rtcore.h"
 #include "point_query.h"
+#include "traversal_statistics.h"
 
 namespace embree
 {
@@ -37,6 +38,14 @@ namespace embree
       return (RTCOccludedFunctionN) args->intersect;
     }
 
+    /*! counts a filter function invocation if the query gets instrumented */
+    __forceinline void countFilterCall() const
+    {
+#if !defined(__SYCL_DEVICE_ONLY__)
+      if (unlikely(stats)) stats->addFilterCall();
+#endif
+    }
+
     __forceinline bool isCoherent() const {
       return embree::isCoherent(args->flags);
     }
@@ -59,6 +68,7 @@ namespace embree
     Scene* scene = nullptr;
     RTCRayQueryContext* user = nullptr;
     RTCIntersectArguments* args = nullptr;
+    TraversalStatistics::Counters* stats = nullptr; //!< traversal statistics to gather, nullptr if the query is not sampled
   };
 
   template<int M, typename Geometry>
@@ -38,6 +38,7 @@ namespace embree
 
   static MutexSys g_mutex;
   static std::map<Device*,size_t> g_cache_size_map;
+  static std::map<Device*,bool> g_cache_lru_map;
   static std::map<Device*,size_t> g_num_threads_map;
   
   struct TaskArena
@@ -102,8 +103,12 @@ namespace embree
 #endif
     State::hugepages_success &= os_init(State::hugepages,State::verbosity(3));
     
-    /*! set tessellation cache size */
+    /*! set tessellation cache size and mode */
     setCacheSize( State::tessellation_cache_size );
+    setCacheLRU( State::tessellation_cache_lru );
+
+    /*! enable runtime traversal statistics */
+    traversalStatistics.setSamplingRate( State::traversal_statistics );
 
     /*! enable some floating point exceptions to catch bugs */
     if (State::float_exceptions)
@@ -138,6 +143,7 @@ namespace embree
   Device::~Device ()
   {
     setCacheSize(0);
+    setCacheLRU(false);
     exitTaskingSystem();
   }
 
@@ -368,6 +374,24 @@ namespace embree
 #endif
   }
 
+  bool getCacheLRU()
+  {
+    for (std::map<Device*,bool>::iterator i=g_cache_lru_map.begin(); i!= g_cache_lru_map.end(); i++)
+      if ((*i).second) return true;
+    return false;
+  }
+
+  void Device::setCacheLRU(bool lru)
+  {
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    Lock<MutexSys> lock(g_mutex);
+    if (!lru) g_cache_lru_map.erase(this);
+    else      g_cache_lru_map[this] = true;
+
+    setTessellationCacheLRU(getCacheLRU());
+#endif
+  }
+
   void Device::initTaskingSystem(size_t numThreads) 
   {
     Lock<MutexSys> lock(g_mutex);
@@ -378,7 +402,7 @@ namespace embree
 
     /* create task scheduler */
     size_t maxNumThreads = getMaxNumThreads();
-    TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+    TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads,State::numa);
 #if USE_TASK_ARENA
     const size_t nThreads = min(maxNumThreads,TaskScheduler::threadCount());
     const size_t uThreads = min(max(numUserThreads,(size_t)1),nThreads);
@@ -398,7 +422,7 @@ namespace embree
     /* or configure new number of threads */
     else {
       size_t maxNumThreads = getMaxNumThreads();
-      TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+      TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads,State::numa);
     }
 #if USE_TASK_ARENA
     arena->arena.reset();
@@ -429,6 +453,30 @@ namespace embree
     case 1000003: debug_int3 = val; return;
     }
 
+    switch (prop)
+    {
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE:
+      if (val < 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid tessellation cache size");
+      setCacheSize(val);
+      return;
+
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MODE:
+      if (val != RTC_TESSELLATION_CACHE_MODE_SEGMENTED && val != RTC_TESSELLATION_CACHE_MODE_LRU)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid tessellation cache mode");
+      setCacheLRU(val == RTC_TESSELLATION_CACHE_MODE_LRU);
+      return;
+
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS:
+      if (val != 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "tessellation cache counters can only get reset to 0");
+      clearTessellationCacheCounters();
+      return;
+#endif
+    default: break;
+    }
+
     throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown writable property");
   }
 
@@ -508,6 +556,8 @@ namespace embree
     case RTC_DEVICE_PROPERTY_COMPACT_POLYS_ENABLED: return 0;
 #endif
 
+    case RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_SAMPLING_RATE: return traversalStatistics.getSamplingRate();
+
 #if defined(EMBREE_FILTER_FUNCTION)
     case RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED: return 1;
 #else
@@ -598,6 +648,14 @@ namespace embree
     case RTC_DEVICE_PROPERTY_SYCL_DEVICE: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE:      return getTessellationCacheSize();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MODE:      return getTessellationCacheLRU() ? RTC_TESSELLATION_CACHE_MODE_LRU : RTC_TESSELLATION_CACHE_MODE_SEGMENTED;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:      return getTessellationCacheCounters().hits;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:    return getTessellationCacheCounters().misses;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS: return getTessellationCacheCounters().evictions;
+#endif
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
@@ -6,6 +6,7 @@
 #include "default.h"
 #include "state.h"
 #include "accel.h"
+#include "traversal_statistics.h"
 
 namespace embree
 {
@@ -105,6 +106,9 @@ namespace embree
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
+    /*! selects least recently used eviction for the software cache. */
+    void setCacheLRU(bool lru);
+
     /*! sets a property */
     void setProperty(const RTCDeviceProperty prop, ssize_t val);
 
@@ -156,6 +160,9 @@ namespace embree
     static ssize_t debug_int2;
     static ssize_t debug_int3;
 
+  public:
+    TraversalStatistics traversalStatistics;  //!< runtime traversal statistics, enabled with the traversal_statistics option
+
   public:
     std::unique_ptr<BVH4Factory> bvh4_factory;
 #if defined(EMBREE_TARGET_SIMD8)
@@ -361,6 +361,11 @@ namespace embree
     virtual void updateBuffer(RTCBufferType type, unsigned int slot) {
       update(); // update everything for geometries not supporting this call
     }
+
+    /*! Update item range [begin,end) of geometry buffer. */
+    virtual void updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end) {
+      updateBuffer(type,slot); // update entire buffer for geometries not supporting this call
+    }
     
     /*! Disable geometry. */
     virtual void disable();
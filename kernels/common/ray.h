@@ -1210,6 +1210,30 @@ namespace embree
       return *(Ray*)((char*)ptr + offset);
     }
 
+    __forceinline void setHitByOffset(size_t offset, const RayHit& ray)
+    {
+      if (ray.geomID != RTC_INVALID_GEOMETRY_ID)
+      {
+        RayHit* __restrict__ ray_o = (RayHit*)((char*)ptr + offset);
+        ray_o->tfar   = ray.tfar;
+        ray_o->Ng     = ray.Ng;
+        ray_o->u      = ray.u;
+        ray_o->v      = ray.v;
+        ray_o->primID = ray.primID;
+        ray_o->geomID = ray.geomID;
+
+        instance_id_stack::copy_UU(ray.instID, ray_o->instID);
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        instance_id_stack::copy_UU(ray.instPrimID, ray_o->instPrimID);
+#endif
+      }
+    }
+
+    __forceinline void setHitByOffset(size_t offset, const Ray& ray)
+    {
+      ((Ray*)((char*)ptr + offset))->tfar = ray.tfar;
+    }
+
     template<int K>
     __forceinline RayK<K> getRayByOffset(const vint<K>& offset);
 
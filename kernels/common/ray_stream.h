@@ -0,0 +1,245 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "scene.h"
+#include "context.h"
+
+namespace embree
+{
+  /*! Traces streams of rays of arbitrary length. The rays of each chunk
+   *  of the stream get sorted by the octant of their direction and the
+   *  Morton code of their origin, and consecutive rays of the same
+   *  octant get repacketized into packets of the widest packet
+   *  intersector of the scene. Packets whose directions turn out to be
+   *  incoherent are traced ray by ray instead. */
+  struct RayStreamTracer
+  {
+    static const size_t MAX_CHUNK_SIZE = 256;                         //!< number of rays sorted at once
+    static const size_t ORG_BITS_PER_DIM = 2;                         //!< resolution of the origin grid used for sorting
+    static const size_t ORG_CELLS_PER_DIM = size_t(1) << ORG_BITS_PER_DIM;
+    static const size_t NUM_BINS = size_t(8) << (3*ORG_BITS_PER_DIM);
+
+    /*! minimal average cosine between the ray directions of a packet
+     *  and their mean direction to use packet traversal */
+    static constexpr float MIN_PACKET_COHERENCE = 0.7f;
+
+    template<typename Stream>
+    static void intersect(Scene* scene, Stream& stream, size_t numRays, size_t stride, RayQueryContext* context)
+    {
+      if      (scene->intersectors.intersector16) traceStream<16,true>(scene,stream,numRays,stride,context);
+      else if (scene->intersectors.intersector8 ) traceStream<8, true>(scene,stream,numRays,stride,context);
+      else if (scene->intersectors.intersector4 ) traceStream<4, true>(scene,stream,numRays,stride,context);
+      else {
+        for (size_t i=0; i<numRays; i++)
+          traceRay<true>(scene,stream,i*stride,stream.getRayByOffset(i*stride),context);
+      }
+    }
+
+    template<typename Stream>
+    static void occluded(Scene* scene, Stream& stream, size_t numRays, size_t stride, RayQueryContext* context)
+    {
+      if      (scene->intersectors.intersector16) traceStream<16,false>(scene,stream,numRays,stride,context);
+      else if (scene->intersectors.intersector8 ) traceStream<8, false>(scene,stream,numRays,stride,context);
+      else if (scene->intersectors.intersector4 ) traceStream<4, false>(scene,stream,numRays,stride,context);
+      else {
+        for (size_t i=0; i<numRays; i++)
+          traceRay<false>(scene,stream,i*stride,stream.getRayByOffset(i*stride),context);
+      }
+    }
+
+  private:
+
+    template<int K, bool intersect, typename Stream>
+    static void traceStream(Scene* scene, Stream& stream, size_t numRays, size_t stride, RayQueryContext* context)
+    {
+      Ray rays[MAX_CHUNK_SIZE];
+      unsigned int keys[MAX_CHUNK_SIZE];
+      unsigned int order[MAX_CHUNK_SIZE];
+      unsigned int counts[NUM_BINS];
+
+      for (size_t chunkBegin=0; chunkBegin<numRays; chunkBegin+=MAX_CHUNK_SIZE)
+      {
+        const size_t chunkSize = min(numRays-chunkBegin,MAX_CHUNK_SIZE);
+
+        /* gather the rays of the chunk */
+        BBox3fa orgBounds(empty);
+        for (size_t i=0; i<chunkSize; i++) {
+          rays[i] = stream.getRayByOffset((chunkBegin+i)*stride);
+          orgBounds.extend(Vec3fa(rays[i].org));
+        }
+
+        /* sort rays by direction octant and origin */
+        const Vec3fa scale = float(ORG_CELLS_PER_DIM)*rcp_safe(orgBounds.size());
+        for (size_t b=0; b<NUM_BINS; b++) counts[b] = 0;
+        for (size_t i=0; i<chunkSize; i++) {
+          keys[i] = key(rays[i],orgBounds.lower,scale);
+          counts[keys[i]]++;
+        }
+        for (size_t b=0, sum=0; b<NUM_BINS; b++) {
+          const unsigned int count = counts[b];
+          counts[b] = (unsigned int) sum;
+          sum += count;
+        }
+        for (size_t i=0; i<chunkSize; i++)
+          order[counts[keys[i]]++] = (unsigned int) i;
+
+        /* trace consecutive rays of the same octant as packets */
+        for (size_t begin=0, end=0; begin<chunkSize; begin=end)
+        {
+          const unsigned int octant = keys[order[begin]] >> (3*ORG_BITS_PER_DIM);
+          for (end=begin+1; end<chunkSize && end-begin<K; end++)
+            if ((keys[order[end]] >> (3*ORG_BITS_PER_DIM)) != octant) break;
+
+          tracePacket<K,intersect>(scene,stream,chunkBegin,stride,rays,order+begin,end-begin,context);
+        }
+      }
+    }
+
+    __forceinline static unsigned int key(const Ray& ray, const Vec3fa& lower, const Vec3fa& scale)
+    {
+      const unsigned int octant = (ray.dir.x < 0.0f ? 1 : 0) | (ray.dir.y < 0.0f ? 2 : 0) | (ray.dir.z < 0.0f ? 4 : 0);
+      const Vec3fa p = (Vec3fa(ray.org)-lower)*scale;
+      const unsigned int x = (unsigned int) clamp(int(p.x),0,int(ORG_CELLS_PER_DIM-1));
+      const unsigned int y = (unsigned int) clamp(int(p.y),0,int(ORG_CELLS_PER_DIM-1));
+      const unsigned int z = (unsigned int) clamp(int(p.z),0,int(ORG_CELLS_PER_DIM-1));
+      unsigned int code = 0;
+      for (size_t b=0; b<ORG_BITS_PER_DIM; b++)
+        code |= (((x >> b) & 1) << (3*b+0)) | (((y >> b) & 1) << (3*b+1)) | (((z >> b) & 1) << (3*b+2));
+      return (octant << (3*ORG_BITS_PER_DIM)) | code;
+    }
+
+    /*! average cosine between the normalized ray directions and their mean direction */
+    __forceinline static float coherence(const Ray* rays, const unsigned int* order, size_t num)
+    {
+      Vec3fa sum(zero);
+      for (size_t i=0; i<num; i++)
+        sum += normalize_safe(Vec3fa(rays[order[i]].dir));
+      return length(sum)/float(num);
+    }
+
+    template<int K, bool intersect, typename Stream>
+    static void tracePacket(Scene* scene, Stream& stream, size_t chunkBegin, size_t stride, Ray* rays, const unsigned int* order, size_t num, RayQueryContext* context)
+    {
+      if (num == 1 || coherence(rays,order,num) < MIN_PACKET_COHERENCE)
+      {
+        for (size_t i=0; i<num; i++)
+          traceRay<intersect>(scene,stream,(chunkBegin+order[i])*stride,rays[order[i]],context);
+        return;
+      }
+
+      /* unused lanes get a copy of the first ray */
+      __aligned(64) int valid[K];
+      RTCRayHitNt<K> packet;
+      for (size_t k=0; k<K; k++) {
+        valid[k] = k < num ? -1 : 0;
+        setRay(packet,k,rays[order[k < num ? k : 0]]);
+      }
+
+      if (intersect) dispatchPacket(scene,valid,packet,context);
+      else           dispatchPacket(scene,valid,packet.ray,context);
+
+      for (size_t k=0; k<num; k++)
+      {
+        const size_t offset = (chunkBegin+order[k])*stride;
+        if (intersect) {
+          RayHit ray;
+          getHit(packet,k,ray);
+          stream.setHitByOffset(offset,ray);
+        } else {
+          Ray& ray = rays[order[k]];
+          ray.tfar = packet.ray.tfar[k];
+          stream.setHitByOffset(offset,ray);
+        }
+      }
+    }
+
+    template<bool intersect, typename Stream>
+    static void traceRay(Scene* scene, Stream& stream, size_t offset, const Ray& ray, RayQueryContext* context)
+    {
+      if (intersect) {
+        RayHit rayhit(ray);
+        for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l) {
+          rayhit.instID[l] = RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+          rayhit.instPrimID[l] = RTC_INVALID_GEOMETRY_ID;
+#endif
+        }
+        scene->intersectors.intersect((RTCRayHit&)rayhit,context);
+        stream.setHitByOffset(offset,rayhit);
+      } else {
+        Ray ray1 = ray;
+        scene->intersectors.occluded((RTCRay&)ray1,context);
+        stream.setHitByOffset(offset,ray1);
+      }
+    }
+
+    template<int K>
+    __forceinline static void setRay(RTCRayHitNt<K>& packet, size_t k, const Ray& ray)
+    {
+      packet.ray.org_x[k] = ray.org.x;
+      packet.ray.org_y[k] = ray.org.y;
+      packet.ray.org_z[k] = ray.org.z;
+      packet.ray.tnear[k] = ray.tnear();
+      packet.ray.dir_x[k] = ray.dir.x;
+      packet.ray.dir_y[k] = ray.dir.y;
+      packet.ray.dir_z[k] = ray.dir.z;
+      packet.ray.time[k]  = ray.time();
+      packet.ray.tfar[k]  = ray.tfar;
+      packet.ray.mask[k]  = ray.mask;
+      packet.ray.id[k]    = ray.id;
+      packet.ray.flags[k] = ray.flags;
+
+      packet.hit.geomID[k] = RTC_INVALID_GEOMETRY_ID;
+      for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l) {
+        packet.hit.instID[l][k] = RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        packet.hit.instPrimID[l][k] = RTC_INVALID_GEOMETRY_ID;
+#endif
+      }
+    }
+
+    template<int K>
+    __forceinline static void getHit(const RTCRayHitNt<K>& packet, size_t k, RayHit& ray)
+    {
+      ray.tfar   = packet.ray.tfar[k];
+      ray.Ng     = Vec3f(packet.hit.Ng_x[k],packet.hit.Ng_y[k],packet.hit.Ng_z[k]);
+      ray.u      = packet.hit.u[k];
+      ray.v      = packet.hit.v[k];
+      ray.primID = packet.hit.primID[k];
+      ray.geomID = packet.hit.geomID[k];
+      for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l) {
+        ray.instID[l] = packet.hit.instID[l][k];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        ray.instPrimID[l] = packet.hit.instPrimID[l][k];
+#endif
+      }
+    }
+
+    __forceinline static void dispatchPacket(Scene* scene, const int* valid, RTCRayHitNt<4>& packet, RayQueryContext* context) {
+      scene->intersectors.intersect4(valid,(RTCRayHit4&)packet,context);
+    }
+
+    __forceinline static void dispatchPacket(Scene* scene, const int* valid, RTCRayHitNt<8>& packet, RayQueryContext* context) {
+      scene->intersectors.intersect8(valid,(RTCRayHit8&)packet,context);
+    }
+
+    __forceinline static void dispatchPacket(Scene* scene, const int* valid, RTCRayHitNt<16>& packet, RayQueryContext* context) {
+      scene->intersectors.intersect16(valid,(RTCRayHit16&)packet,context);
+    }
+
+    __forceinline static void dispatchPacket(Scene* scene, const int* valid, RTCRayNt<4>& packet, RayQueryContext* context) {
+      scene->intersectors.occluded4(valid,(RTCRay4&)packet,context);
+    }
+
+    __forceinline static void dispatchPacket(Scene* scene, const int* valid, RTCRayNt<8>& packet, RayQueryContext* context) {
+      scene->intersectors.occluded8(valid,(RTCRay8&)packet,context);
+    }
+
+    __forceinline static void dispatchPacket(Scene* scene, const int* valid, RTCRayNt<16>& packet, RayQueryContext* context) {
+      scene->intersectors.occluded16(valid,(RTCRay16&)packet,context);
+    }
+  };
+}
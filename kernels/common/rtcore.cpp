@@ -7,6 +7,7 @@
 #include "device.h"
 #include "scene.h"
 #include "context.h"
+#include "ray_stream.h"
 #include "../geometry/filter.h"
 #include "../../include/embree4/rtcore_ray.h"
 using namespace embree;
@@ -190,6 +191,38 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END(device);
   }
 
+  RTC_API void rtcGetDeviceTraversalStatistics(RTCDevice hdevice, RTCQueryType type, RTCTraversalStatistics* statistics_o)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetDeviceTraversalStatistics);
+    RTC_VERIFY_HANDLE(hdevice);
+    if (statistics_o == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid statistics pointer");
+    if (type != RTC_QUERY_TYPE_INTERSECT && type != RTC_QUERY_TYPE_OCCLUDED)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid query type");
+
+    TraversalStatistics::Counters counters;
+    device->traversalStatistics.get(type == RTC_QUERY_TYPE_INTERSECT ? TraversalStatistics::INTERSECT : TraversalStatistics::OCCLUDED, counters);
+    statistics_o->numRays        = counters.rays;
+    statistics_o->numSampledRays = counters.sampledRays;
+    statistics_o->numNodes       = counters.nodes;
+    statistics_o->numLeaves      = counters.leaves;
+    statistics_o->numPrimitives  = counters.primitives;
+    statistics_o->numFilterCalls = counters.filterCalls;
+    RTC_CATCH_END(device);
+  }
+
+  RTC_API void rtcResetDeviceTraversalStatistics(RTCDevice hdevice)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcResetDeviceTraversalStatistics);
+    RTC_VERIFY_HANDLE(hdevice);
+    device->traversalStatistics.clear();
+    RTC_CATCH_END(device);
+  }
+
   RTC_API RTCBuffer rtcNewBuffer(RTCDevice hdevice, size_t byteSize)
   {
     RTC_CATCH_BEGIN;
@@ -396,6 +429,17 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcCommitScenes (RTCScene* hscenes, const int* priorities, unsigned int numScenes)
+  {
+    Scene* scene = (hscenes && numScenes) ? (Scene*) hscenes[0] : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitScenes);
+    if (numScenes == 0) return;
+    RTC_VERIFY_HANDLE(hscenes);
+    Scene::commitScenes((Scene**)hscenes, priorities, numScenes);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -445,6 +489,44 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcGetSceneBuildStatistics(RTCScene hscene, RTCSceneBuildStatistics* statistics_o)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBuildStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    if (statistics_o == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid destination pointer");
+    if (scene->isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+
+    memset(statistics_o,0,sizeof(RTCSceneBuildStatistics));
+    statistics_o->time = scene->commitTime;
+    statistics_o->numThreads = (unsigned int) scene->commitThreadCount;
+    const double numThreads = double(max(scene->commitThreadCount,size_t(1)));
+
+    for (size_t i=0; i<scene->accels.size() && statistics_o->numAccels < RTC_MAX_BUILD_STATISTICS_ACCEL_COUNT; i++)
+    {
+      const BuildStatistics& stats = scene->accels[i]->buildStatistics;
+      RTCAccelBuildStatistics& accel = statistics_o->accels[statistics_o->numAccels++];
+      strncpy(accel.builder,stats.builder.c_str(),sizeof(accel.builder)-1);
+      accel.numPrimitives = stats.numPrimitives;
+      accel.time = stats.time;
+      accel.bytesAllocated = stats.bytesAllocated;
+      for (size_t j=0; j<BuildStatistics::NUM_PHASES; j++)
+      {
+        const BuildStatistics::PhaseStatistics& phase = stats.phases[j];
+        accel.phases[j].time = phase.time;
+        accel.phases[j].threadTime = phase.threadTime;
+        accel.phases[j].threadUtilization = phase.time > 0.0 ? phase.threadTime/(phase.time*numThreads) : 0.0;
+        accel.phases[j].bytesAllocated = phase.bytesAllocated;
+      }
+      accel.numFineBinningSplits = stats.numFineBinningSplits;
+      accel.fineBinningSAHSaved = stats.fineBinningSAHDefault > 0.0 ? stats.fineBinningSAHSaved/stats.fineBinningSAHDefault : 0.0;
+    }
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcCollide (RTCScene hscene0, RTCScene hscene1, RTCCollideFunc callback, void* userPtr)
   {
     Scene* scene0 = (Scene*) hscene0;
@@ -621,6 +703,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::INTERSECT,1);
     
     scene->intersectors.intersect(*rayhit,&context);
 #if defined(DEBUG)
@@ -656,6 +739,7 @@ RTC_NAMESPACE_BEGIN;
 
     RTCIntersectArguments* iargs = ((IntersectFunctionNArguments*) args)->args;
     RayQueryContext context(scene,user_context,iargs);
+    context.stats = ((IntersectFunctionNArguments*) args)->stats;
 
     instance_id_stack::push(user_context, instID, instPrimID);
     scene->intersectors.intersect(*(RTCRayHit*)oray,&context);
@@ -695,6 +779,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::INTERSECT,valid,4);
 
     if (likely(scene->intersectors.intersector4))
       scene->intersectors.intersect4(valid,*rayhit,&context);
@@ -766,6 +851,7 @@ RTC_NAMESPACE_BEGIN;
 
     RTCIntersectArguments* iargs = ((IntersectFunctionNArguments*) args)->args;
     RayQueryContext context(scene,user_context,iargs);
+    context.stats = ((IntersectFunctionNArguments*) args)->stats;
 
     instance_id_stack::push(user_context, instID, instPrimID);
     scene->intersectors.intersect(valid,*oray,&context);
@@ -822,6 +908,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::INTERSECT,valid,8);
     
     if (likely(scene->intersectors.intersector8)) 
       scene->intersectors.intersect8(valid,*rayhit,&context);
@@ -883,6 +970,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::INTERSECT,valid,16);
 
     if (likely(scene->intersectors.intersector16))
       scene->intersectors.intersect16(valid,*rayhit,&context);
@@ -915,6 +1003,70 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcIntersect1M (RTCScene hscene, RTCRayHit* rayhit, unsigned int M, size_t byteStride, RTCIntersectArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect1M);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");
+    if (byteStride & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "stride not aligned to 16 bytes");
+#endif
+    STAT3(normal.travs,M,M,M);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::INTERSECT,M);
+
+    RayStreamAOS stream(rayhit);
+    RayStreamTracer::intersect(scene,stream,M,byteStride,&context);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersectNp (RTCScene hscene, const RTCRayHitNp* rayhit, unsigned int N, RTCIntersectArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectNp);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+#endif
+    STAT3(normal.travs,N,N,N);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::INTERSECT,N);
+
+    RayStreamSOP& stream = *(RayStreamSOP*)rayhit;
+    RayStreamTracer::intersect(scene,stream,N,sizeof(float),&context);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcOccluded1 (RTCScene hscene, RTCRay* ray, RTCOccludedArguments* args) 
   {
     Scene* scene = (Scene*) hscene;
@@ -940,6 +1092,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::OCCLUDED,1);
     
     scene->intersectors.occluded(*ray,&context);
     RTC_CATCH_END2(scene);
@@ -973,6 +1126,7 @@ RTC_NAMESPACE_BEGIN;
 
     RTCIntersectArguments* iargs = ((OccludedFunctionNArguments*) args)->args;
     RayQueryContext context(scene,user_context,iargs);
+    context.stats = ((OccludedFunctionNArguments*) args)->stats;
 
     instance_id_stack::push(user_context, instID, instPrimID);
     scene->intersectors.occluded(*(RTCRay*)oray,&context);
@@ -1012,6 +1166,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::OCCLUDED,valid,4);
 
     if (likely(scene->intersectors.intersector4))
        scene->intersectors.occluded4(valid,*ray,&context);
@@ -1062,6 +1217,7 @@ RTC_NAMESPACE_BEGIN;
 
     RTCIntersectArguments* iargs = ((IntersectFunctionNArguments*) args)->args;
     RayQueryContext context(scene,user_context,iargs);
+    context.stats = ((IntersectFunctionNArguments*) args)->stats;
 
     instance_id_stack::push(user_context, instID, instPrimID);
     scene->intersectors.occluded(valid,*oray,&context);
@@ -1118,6 +1274,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::OCCLUDED,valid,8);
 
     if (likely(scene->intersectors.intersector8))
       scene->intersectors.occluded8(valid,*ray,&context);
@@ -1178,6 +1335,7 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::OCCLUDED,valid,16);
 
     if (likely(scene->intersectors.intersector16))
       scene->intersectors.occluded16(valid,*ray,&context);
@@ -1210,6 +1368,70 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcOccluded1M (RTCScene hscene, RTCRay* ray, unsigned int M, size_t byteStride, RTCOccludedArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcOccluded1M);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");
+    if (byteStride & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "stride not aligned to 16 bytes");
+#endif
+    STAT3(shadow.travs,M,M,M);
+
+    RTCOccludedArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitOccludedArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::OCCLUDED,M);
+
+    RayStreamAOS stream(ray);
+    RayStreamTracer::occluded(scene,stream,M,byteStride,&context);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcOccludedNp (RTCScene hscene, const RTCRayNp* ray, unsigned int N, RTCOccludedArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcOccludedNp);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+#endif
+    STAT3(shadow.travs,N,N,N);
+
+    RTCOccludedArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitOccludedArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    context.stats = scene->device->traversalStatistics.beginQuery(TraversalStatistics::OCCLUDED,N);
+
+    RayStreamSOP& stream = *(RayStreamSOP*)ray;
+    RayStreamTracer::occluded(scene,stream,N,sizeof(float),&context);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API bool rtcTraversablePointQuery(RTCTraversable htraversable, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
   {
     return rtcPointQuery((RTCScene)htraversable, query, userContext, queryFunc, userPtr);
@@ -1522,15 +1744,19 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
   RTC_API void rtcInvokeIntersectFilterFromGeometry(const struct RTCIntersectFunctionNArguments* const args_i, const struct RTCFilterFunctionNArguments* filter_args)
   {
     IntersectFunctionNArguments* args = (IntersectFunctionNArguments*) args_i;
-    if (args->geometry->intersectionFilterN)
-        args->geometry->intersectionFilterN(filter_args);
+    if (args->geometry->intersectionFilterN) {
+      args->geometry->intersectionFilterN(filter_args);
+      if (unlikely(args->stats)) args->stats->addFilterCall();
+    }
   }
 
   RTC_API void rtcInvokeOccludedFilterFromGeometry(const struct RTCOccludedFunctionNArguments* const args_i, const struct RTCFilterFunctionNArguments* filter_args)
   {
     OccludedFunctionNArguments* args = (OccludedFunctionNArguments*) args_i;
-    if (args->geometry->occlusionFilterN)
+    if (args->geometry->occlusionFilterN) {
       args->geometry->occlusionFilterN(filter_args);
+      if (unlikely(args->stats)) args->stats->addFilterCall();
+    }
   }
   
   RTC_API RTCGeometry rtcNewGeometry (RTCDevice hdevice, RTCGeometryType type)
@@ -2025,6 +2251,16 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcUpdateGeometryBufferRange (RTCGeometry hgeometry, RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcUpdateGeometryBufferRange);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->updateBufferRange(type, slot, itemOffset, itemOffset+itemCount);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcDisableGeometry (RTCGeometry hgeometry) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -10,6 +10,8 @@
 
 #include "../../common/algorithms/parallel_reduce.h"
 
+#include <queue>
+
 #if defined(EMBREE_SYCL_SUPPORT)
 #  include "../sycl/rthwif_embree_builder.h"
 #endif
@@ -58,7 +60,8 @@ namespace embree
       geometry_data_host(nullptr),
 #endif
       taskGroup(new TaskGroup()),
-      progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0)
+      progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0),
+      commitTime(0.0), commitThreadCount(0)
   {
     device->refInc();
 
@@ -155,7 +158,7 @@ namespace embree
 
     if (device->tri_accel == "default") 
     {
-      if (quality_flags != RTC_BUILD_QUALITY_LOW)
+      if (quality_flags != RTC_BUILD_QUALITY_LOW && !isIncrementalBuild())
       {	
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
         switch (mode) {
@@ -187,7 +190,14 @@ namespace embree
             accels_add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
 
           break;
-        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b10*/ 2:
+#if defined (EMBREE_TARGET_SIMD8)
+          if (device->canUseAVX())
+            accels_add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
+          else
+#endif
+            accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  ));
+          break;
         case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -279,7 +289,7 @@ namespace embree
     
     if (device->quad_accel == "default") 
     {
-      if (quality_flags != RTC_BUILD_QUALITY_LOW)
+      if (quality_flags != RTC_BUILD_QUALITY_LOW && !isIncrementalBuild())
       {
         /* static */
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
@@ -312,7 +322,14 @@ namespace embree
             accels_add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
           break;
 
-        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST)); break;
+        case /*0b10*/ 2:
+#if defined (EMBREE_TARGET_SIMD8)
+          if (device->canUseAVX())
+            accels_add(device->bvh8_factory->BVH8QuantizedQuad4i(this));
+          else
+#endif
+            accels_add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST));
+          break;
         case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -542,7 +559,10 @@ namespace embree
     // if (device->object_accel == "default") 
     {
 #if defined (EMBREE_TARGET_SIMD8)
-      if (device->canUseAVX() && !isCompactAccel()) {
+      if (device->canUseAVX() && isCompactAccel() && quality_flags != RTC_BUILD_QUALITY_LOW) {
+        accels_add(device->bvh8_factory->BVH8QuantizedInstance(this, false));
+      }
+      else if (device->canUseAVX() && !isCompactAccel()) {
         if (quality_flags != RTC_BUILD_QUALITY_LOW) {
           accels_add(device->bvh8_factory->BVH8Instance(this, false, BVHFactory::BuildVariant::STATIC));
         } else {
@@ -586,7 +606,10 @@ namespace embree
     // if (device->object_accel == "default") 
     {
 #if defined (EMBREE_TARGET_SIMD8)
-      if (device->canUseAVX() && !isCompactAccel()) {
+      if (device->canUseAVX() && isCompactAccel() && quality_flags != RTC_BUILD_QUALITY_LOW) {
+        accels_add(device->bvh8_factory->BVH8QuantizedInstance(this, true));
+      }
+      else if (device->canUseAVX() && !isCompactAccel()) {
         if (quality_flags != RTC_BUILD_QUALITY_LOW) {
           accels_add(device->bvh8_factory->BVH8Instance(this, true, BVHFactory::BuildVariant::STATIC));
         } else {
@@ -630,7 +653,10 @@ namespace embree
     // if (device->object_accel == "default") 
     {
 #if defined (EMBREE_TARGET_SIMD8)
-      if (device->canUseAVX() && !isCompactAccel()) {
+      if (device->canUseAVX() && isCompactAccel() && quality_flags != RTC_BUILD_QUALITY_LOW) {
+        accels_add(device->bvh8_factory->BVH8QuantizedInstanceArray(this));
+      }
+      else if (device->canUseAVX() && !isCompactAccel()) {
         if (quality_flags != RTC_BUILD_QUALITY_LOW) {
           accels_add(device->bvh8_factory->BVH8InstanceArray(this, BVHFactory::BuildVariant::STATIC));
         } else {
@@ -803,8 +829,8 @@ namespace embree
     /* build all hierarchies of this scene */
     accels_build();
 
-    /* make static geometry immutable */
-    if (!isDynamicAccel()) {
+    /* make static geometry immutable, in incremental build mode the builders are kept to only rebuild modified geometries */
+    if (!isDynamicAccel() && !isIncrementalBuild()) {
       accels_immutable();
       flags_modified = true; // in non-dynamic mode we have to re-create accels
     }
@@ -830,6 +856,7 @@ namespace embree
     checkIfModifiedAndSet();
     if (!isModified()) return;
     
+    const double t0 = getSeconds();
 
     /* print scene statistics */
     if (device->verbosity(2))
@@ -883,6 +910,8 @@ namespace embree
         }
       });
 
+    commitTime = getSeconds()-t0;
+    commitThreadCount = TaskScheduler::threadCount();
     setModified(false);
   }
 
@@ -925,6 +954,183 @@ namespace embree
 #endif
   }
 
+  void Scene::commitScenes (Scene** scenes_in, const int* priorities_in, size_t numScenes_in)
+  {
+    /* gather distinct scenes, a scene passed multiple times gets its highest priority */
+    std::vector<Scene*> scenes;
+    std::vector<int> priorities;
+    std::map<Scene*,size_t> index;
+    for (size_t i=0; i<numScenes_in; i++)
+    {
+      Scene* scene = scenes_in[i];
+      if (scene == nullptr)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid argument");
+      if (scene->device != scenes_in[0]->device)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"scenes belong to different devices");
+      
+      const int priority = priorities_in ? priorities_in[i] : 0;
+      auto it = index.find(scene);
+      if (it == index.end()) {
+        index[scene] = scenes.size();
+        scenes.push_back(scene);
+        priorities.push_back(priority);
+      } else {
+        priorities[it->second] = max(priorities[it->second],priority);
+      }
+    }
+    const size_t N = scenes.size();
+    if (N == 0) return;
+
+    /* a scene depends on all scenes of the batch it instances */
+    std::vector<std::vector<size_t>> parents(N);
+    std::vector<size_t> numChildren(N,0);
+    for (size_t i=0; i<N; i++)
+    {
+      std::set<size_t> children;
+      auto addChild = [&] (Accel* object) {
+        if (object == nullptr) return;
+        auto it = index.find(static_cast<Scene*>(object));
+        if (it != index.end()) children.insert(it->second);
+      };
+      
+      for (size_t geomID=0; geomID<scenes[i]->size(); geomID++)
+      {
+        Geometry* geom = scenes[i]->get(geomID);
+        if (geom == nullptr) continue;
+        if (geom->getTypeMask() & Geometry::MTY_INSTANCE)
+          addChild(((Instance*)geom)->object);
+        else if (geom->getTypeMask() & Geometry::MTY_INSTANCE_ARRAY) {
+          InstanceArray* array = (InstanceArray*) geom;
+          for (size_t j=0; j<array->numInstancedObjects(); j++)
+            addChild(array->getInstancedObject(j));
+        }
+      }
+      for (size_t c : children) parents[c].push_back(i);
+      numChildren[i] = children.size();
+    }
+
+    /* sort scenes topologically, which fails if scenes instance each other cyclically */
+    std::vector<size_t> order; order.reserve(N);
+    std::vector<size_t> remaining(numChildren);
+    for (size_t i=0; i<N; i++)
+      if (remaining[i] == 0) order.push_back(i);
+    for (size_t k=0; k<order.size(); k++)
+      for (size_t p : parents[order[k]])
+        if (--remaining[p] == 0) order.push_back(p);
+    if (order.size() != N)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes instance each other cyclically");
+
+    /* an instanced scene inherits the priority of the scenes waiting for it */
+    for (size_t k=N; k>0; k--)
+      for (size_t p : parents[order[k-1]])
+        priorities[order[k-1]] = max(priorities[order[k-1]],priorities[p]);
+
+    /* each task commits the ready scene of highest priority and spawns one task per scene that got ready */
+    MutexSys readyMutex;
+    auto lower = [&] (size_t a, size_t b) { return priorities[a] < priorities[b]; };
+    std::priority_queue<size_t,std::vector<size_t>,decltype(lower)> ready(lower);
+    remaining = numChildren;
+    for (size_t i=0; i<N; i++)
+      if (remaining[i] == 0) ready.push(i);
+    const size_t numInitialReady = ready.size();
+
+    std::function<void(size_t)> process = [&] (size_t)
+    {
+      size_t i;
+      {
+        Lock<MutexSys> lock(readyMutex);
+        i = ready.top(); ready.pop();
+      }
+      scenes[i]->commit_task();
+
+      size_t numReady = 0;
+      {
+        Lock<MutexSys> lock(readyMutex);
+        for (size_t p : parents[i])
+          if (--remaining[p] == 0) { ready.push(p); numReady++; }
+      }
+      parallel_for(numReady, process);
+    };
+
+    /* lock scenes in address order to not deadlock with concurrent batches */
+    std::vector<Scene*> locked(scenes);
+    std::sort(locked.begin(),locked.end());
+
+#if defined(TASKING_INTERNAL)
+
+    /* all scenes share one task scheduler, thus rtcJoinCommitScene on any of them joins the entire batch */
+    Ref<TaskScheduler> scheduler = new TaskScheduler;
+    auto resetSchedulers = [&] () {
+      for (Scene* scene : locked) {
+        Lock<MutexSys> lock(scene->taskGroup->schedulerMutex);
+        scene->taskGroup->scheduler = nullptr;
+      }
+    };
+    
+    for (Scene* scene : locked)
+    {
+      /* wait for a running commit of that scene to finish */
+      while (true)
+      {
+        {
+          Lock<MutexSys> lock(scene->taskGroup->schedulerMutex);
+          if (scene->taskGroup->scheduler == null) {
+            scene->buildMutex.lock();
+            scene->taskGroup->scheduler = scheduler;
+            break;
+          }
+        }
+        yield();
+      }
+    }
+
+    try {
+      TaskScheduler::TaskGroupContext context;
+      scheduler->spawn_root([&]() { parallel_for(numInitialReady, process); resetSchedulers(); }, &context, 1, true);
+    }
+    catch (...) {
+      resetSchedulers();
+      for (Scene* scene : locked) {
+        scene->accels_clear();
+        scene->buildMutex.unlock();
+      }
+      throw;
+    }
+    for (Scene* scene : locked)
+      scene->buildMutex.unlock();
+
+#else
+
+    for (Scene* scene : locked)
+      scene->buildMutex.lock();
+
+    /* for best performance set FTZ and DAZ flags in the MXCSR control and status register */
+    const unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
+
+    try {
+      parallel_for(numInitialReady, process);
+      _mm_setcsr(mxcsr);
+    }
+    catch (...) {
+      _mm_setcsr(mxcsr);
+      for (Scene* scene : locked) {
+        scene->accels_clear();
+        scene->buildMutex.unlock();
+      }
+      throw;
+    }
+    for (Scene* scene : locked)
+      scene->buildMutex.unlock();
+    
+#endif
+
+#if defined(EMBREE_SYCL_SUPPORT)
+    for (size_t k=0; k<N; k++)
+      scenes[order[k]]->syncWithDevice();
+#endif
+  }
+
   Scene* Scene::getTraversable() {
 #if defined(EMBREE_SYCL_SUPPORT)
     if(device->is_gpu()) {
@@ -198,6 +198,9 @@ namespace embree
 #endif
     void commit (bool join);
     void commit_task ();
+
+    /*! commits multiple scenes as one task graph, instanced scenes are built before the scenes instancing them */
+    static void commitScenes (Scene** scenes, const int* priorities, size_t numScenes);
     void build () {}
 
     Scene* getTraversable();
@@ -301,6 +304,7 @@ namespace embree
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+    __forceinline bool isIncrementalBuild() const { return device->incremental_build && quality_flags == RTC_BUILD_QUALITY_MEDIUM; }
     
     __forceinline bool hasArgumentFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS;
@@ -384,6 +388,10 @@ namespace embree
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr);
 
+  public:
+    double commitTime;        //!< wall clock time of the last commit
+    size_t commitThreadCount; //!< number of threads available to the last commit
+
   private:
     GeometryCounts world;               //!< counts for geometry
 
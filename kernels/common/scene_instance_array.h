@@ -186,6 +186,16 @@ namespace embree
       return area(bounds(i));
     }
 
+    /*! returns the number of distinct instanced scenes */
+    inline size_t numInstancedObjects() const {
+      return object ? 1 : numObjects;
+    }
+
+    /*! returns the i'th distinct instanced scene */
+    inline Accel* getInstancedObject(size_t i) const {
+      return object ? object : objects[i];
+    }
+
     inline Accel* getObject(size_t i) const {
       if (object) {
         return object;
@@ -6,8 +6,8 @@
 #include "../subdiv/patch_eval.h"
 #include "../subdiv/patch_eval_simd.h"
 
-#include "../../common/algorithms/parallel_map.h"
-#include "../../common/algorithms/parallel_set.h"
+#include "../../common/algorithms/parallel_hash_map.h"
+#include "../../common/algorithms/parallel_hash_set.h"
 #include "../../common/algorithms/parallel_sort.h"
 #include "../../common/algorithms/parallel_prefix_sum.h"
 #include "../../common/algorithms/parallel_for.h"
@@ -20,13 +20,13 @@ namespace embree
 #if defined(EMBREE_LOWEST_ISA)
 
   struct VertexCreaseMap {
-    parallel_map<uint32_t,float> vertexCreaseMap;
+    parallel_hash_map<uint32_t,float> vertexCreaseMap;
   };
   struct EdgeCreaseMap {
-    parallel_map<uint64_t,float> edgeCreaseMap;
+    parallel_hash_map<uint64_t,float> edgeCreaseMap;
   };
   struct HoleSet{
-    parallel_set<uint32_t> holeSet;
+    parallel_hash_set<uint32_t> holeSet;
   };
 
   SubdivMesh::SubdivMesh (Device* device)
@@ -365,6 +365,24 @@ namespace embree
     Geometry::update();
   }
 
+  void SubdivMesh::updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end)
+  {
+    if (type != RTC_BUFFER_TYPE_INDEX) {
+      updateBuffer(type,slot);
+      return;
+    }
+
+    if (slot >= topology.size())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer slot");
+    if (begin > end || end > topology[slot].vertexIndices.size())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer range");
+
+    commitCounter++;
+    topology[slot].vertexIndices.setModified(begin,end);
+
+    Geometry::update();
+  }
+
   void SubdivMesh::setDisplacementFunction (RTCDisplacementFunctionN func) 
   {
     this->displFunc = func;
@@ -383,7 +401,7 @@ namespace embree
   }
 
   SubdivMesh::Topology::Topology(SubdivMesh* mesh)
-    : mesh(mesh), subdiv_mode(RTC_SUBDIVISION_MODE_SMOOTH_BOUNDARY), halfEdges(mesh->device,0)
+    : mesh(mesh), subdiv_mode(RTC_SUBDIVISION_MODE_SMOOTH_BOUNDARY), halfEdges(mesh->device,0), vertexIndicesModCounter(0)
   {
   }
   
@@ -417,6 +435,45 @@ namespace embree
     return true;
   }
 
+  /*! links the N half edges returned by getEdge that share the same key */
+  template<typename GetEdge>
+  __forceinline void linkAdjacentHalfEdges(size_t N, const GetEdge& getEdge)
+  {
+    /* border edges are identified by not having an opposite edge set */
+    if (N == 1) {
+      getEdge(0)->edge_crease_weight = float(inf);
+    }
+
+    /* standard edge shared between two faces */
+    else if (N == 2)
+    {
+      /* create edge crease if winding order mismatches between neighboring patches */
+      if (getEdge(0)->getEndVertexIndex() != getEdge(1)->getStartVertexIndex())
+      {
+        getEdge(0)->edge_crease_weight = float(inf);
+        getEdge(1)->edge_crease_weight = float(inf);
+      }
+      /* otherwise mark edges as opposites of each other */
+      else {
+        getEdge(0)->setOpposite(getEdge(1));
+        getEdge(1)->setOpposite(getEdge(0));
+      }
+    }
+
+    /* non-manifold geometry is handled by keeping vertices fixed during subdivision */
+    else {
+      for (size_t i=0; i<N; i++) {
+        getEdge(i)->vertex_crease_weight = inf;
+        getEdge(i)->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
+        getEdge(i)->edge_crease_weight = inf;
+
+        getEdge(i)->next()->vertex_crease_weight = inf;
+        getEdge(i)->next()->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
+        getEdge(i)->next()->edge_crease_weight = inf;
+      }
+    }
+  }
+
   void SubdivMesh::Topology::calculateHalfEdges()
   {
     const size_t blockSize = 4096;
@@ -427,6 +484,7 @@ namespace embree
     /* allocate temporary array */
     halfEdges0.resize(numEdges);
     halfEdges1.resize(numEdges);
+    modifiedHalfEdges.clear();
 
     /* create all half edges */
     parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
@@ -488,40 +546,7 @@ namespace embree
 	const uint64_t key = halfEdges1[e].key;
 	if (key == std::numeric_limits<uint64_t>::max()) break;
 	size_t N=1; while (e+N<numHalfEdges && halfEdges1[e+N].key == key) N++;
-
-        /* border edges are identified by not having an opposite edge set */
-	if (N == 1) {
-          halfEdges1[e].edge->edge_crease_weight = float(inf);
-	}
-
-        /* standard edge shared between two faces */
-        else if (N == 2)
-        {
-          /* create edge crease if winding order mismatches between neighboring patches */
-          if (halfEdges1[e+0].edge->next()->vtx_index != halfEdges1[e+1].edge->vtx_index)
-          {
-            halfEdges1[e+0].edge->edge_crease_weight = float(inf);
-            halfEdges1[e+1].edge->edge_crease_weight = float(inf);
-          }
-          /* otherwise mark edges as opposites of each other */
-          else {
-            halfEdges1[e+0].edge->setOpposite(halfEdges1[e+1].edge);
-            halfEdges1[e+1].edge->setOpposite(halfEdges1[e+0].edge);
-          }
-	}
-
-        /* non-manifold geometry is handled by keeping vertices fixed during subdivision */
-        else {
-	  for (size_t i=0; i<N; i++) {
-	    halfEdges1[e+i].edge->vertex_crease_weight = inf;
-            halfEdges1[e+i].edge->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
-            halfEdges1[e+i].edge->edge_crease_weight = inf;
-
-	    halfEdges1[e+i].edge->next()->vertex_crease_weight = inf;
-            halfEdges1[e+i].edge->next()->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
-            halfEdges1[e+i].edge->next()->edge_crease_weight = inf;
-	  }
-	}
+        linkAdjacentHalfEdges(N,[&] (size_t i) { return halfEdges1[e+i].edge; });
 	e+=N;
       }
     });
@@ -530,41 +555,44 @@ namespace embree
     parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
     {
       for (size_t f=r.begin(); f<r.end(); f++) 
-      {
-        HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
-
-        /* for vertex topology we also test if vertices are valid */
-        if (this == &mesh->topology[0])
-        {
-          /* calculate if face is valid */
-          for (size_t t=0; t<mesh->numTimeSteps; t++)
-            mesh->invalidFace(f,t) = !edge->valid(mesh->vertices[t]) || mesh->holeSet->holeSet.lookup(unsigned(f));
-        }
+        updateFace(f);
+    });
+  }
 
-        /* pin some edges and vertices */
-        for (size_t i=0; i<mesh->faceVertices[f]; i++) 
-        {
-          /* pin corner vertices when requested by user */
-          if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_CORNERS && edge[i].isCorner())
-            edge[i].vertex_crease_weight = float(inf);
-          
-          /* pin all border vertices when requested by user */
-          else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_BOUNDARY && edge[i].vertexHasBorder()) 
-            edge[i].vertex_crease_weight = float(inf);
+  void SubdivMesh::Topology::updateFace(size_t f)
+  {
+    HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
 
-          /* pin all edges and vertices when requested by user */
-          else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_ALL) {
-            edge[i].edge_crease_weight = float(inf);
-            edge[i].vertex_crease_weight = float(inf);
-          }
-        }
+    /* for vertex topology we also test if vertices are valid */
+    if (this == &mesh->topology[0])
+    {
+      /* calculate if face is valid */
+      for (size_t t=0; t<mesh->numTimeSteps; t++)
+        mesh->invalidFace(f,t) = !edge->valid(mesh->vertices[t]) || mesh->holeSet->holeSet.lookup(unsigned(f));
+    }
 
-        /* we have to calculate patch_type last! */
-        HalfEdge::PatchType patch_type = edge->patchType();
-        for (size_t i=0; i<mesh->faceVertices[f]; i++) 
-          edge[i].patch_type = patch_type;
+    /* pin some edges and vertices */
+    for (size_t i=0; i<mesh->faceVertices[f]; i++) 
+    {
+      /* pin corner vertices when requested by user */
+      if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_CORNERS && edge[i].isCorner())
+        edge[i].vertex_crease_weight = float(inf);
+      
+      /* pin all border vertices when requested by user */
+      else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_BOUNDARY && edge[i].vertexHasBorder()) 
+        edge[i].vertex_crease_weight = float(inf);
+
+      /* pin all edges and vertices when requested by user */
+      else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_ALL) {
+        edge[i].edge_crease_weight = float(inf);
+        edge[i].vertex_crease_weight = float(inf);
       }
-    });
+    }
+
+    /* we have to calculate patch_type last! */
+    HalfEdge::PatchType patch_type = edge->patchType();
+    for (size_t i=0; i<mesh->faceVertices[f]; i++) 
+      edge[i].patch_type = patch_type;
   }
 
   void SubdivMesh::Topology::updateHalfEdges()
@@ -572,9 +600,9 @@ namespace embree
     /* we always use the geometry topology to lookup creases */
     mvector<HalfEdge>& halfEdgesGeom = mesh->topology[0].halfEdges;
 
-    /* assume we do no longer recalculate in the future and clear these arrays */
+    /* assume we do no longer recalculate in the future and clear the temporary array,
+     * the sorted half edges are kept for incremental updates */
     halfEdges0.clear();
-    halfEdges1.clear();
 
     /* calculate which data to update */
     const bool updateEdgeCreases   = mesh->topology[0].vertexIndices.isLocalModified() || mesh->edge_creases.isLocalModified()   || mesh->edge_crease_weights.isLocalModified();
@@ -624,6 +652,171 @@ namespace embree
     });
   }
 
+  bool SubdivMesh::Topology::isHoleEdge(size_t i) const {
+    return mesh->holeSet->holeSet.lookup(mesh->halfEdgeFace[i]);
+  }
+
+  void SubdivMesh::Topology::findHalfEdges(uint64_t key, std::vector<HalfEdge*>& edges) const
+  {
+    const size_t first = edges.size();
+    const KeyHalfEdge k(key,nullptr);
+
+    /* entries are outdated if the edge got patched to a different key later */
+    auto r0 = std::equal_range(halfEdges1.begin(),halfEdges1.begin()+mesh->numHalfEdges,k);
+    for (auto i=r0.first; i!=r0.second; i++)
+      if ((uint64_t)i->edge->getEdge() == key) edges.push_back(i->edge);
+
+    auto r1 = std::equal_range(modifiedHalfEdges.begin(),modifiedHalfEdges.end(),k);
+    for (auto i=r1.first; i!=r1.second; i++)
+      if ((uint64_t)i->edge->getEdge() == key) edges.push_back(i->edge);
+
+    /* edges patched back to their original key are found twice */
+    std::sort(edges.begin()+first,edges.end());
+    edges.erase(std::unique(edges.begin()+first,edges.end()),edges.end());
+  }
+
+  bool SubdivMesh::Topology::updateHalfEdgesIncremental(size_t begin, size_t end)
+  {
+    const size_t blockSize = 64;
+    const size_t numHalfEdges = mesh->numHalfEdges;
+    
+    /* nothing to do if no index of some face got modified */
+    end = min(end,numHalfEdges);
+    if (begin >= end) return true;
+
+    /* adjacent edges are found using the sorted half edges of the last recalculation */
+    if (halfEdges1.size() < numHalfEdges) return false;
+
+    /* extend modified range to all half edges of the touched faces */
+    const unsigned int firstFace = mesh->halfEdgeFace[begin];
+    const unsigned int lastFace  = mesh->halfEdgeFace[end-1];
+    const size_t edgeBegin = mesh->faceStartEdge[firstFace];
+    const size_t edgeEnd   = mesh->faceStartEdge[lastFace] + mesh->faceVertices[lastFace];
+
+    /* recalculation is faster when many edges changed */
+    if (16*(edgeEnd-edgeBegin+modifiedHalfEdges.size()) > numHalfEdges)
+      return false;
+
+    /* the old and new keys identify all edges whose adjacency may change */
+    std::vector<uint64_t> keys;
+    for (size_t i=edgeBegin; i<edgeEnd; i++)
+      if (!isHoleEdge(i)) keys.push_back(halfEdges[i].getEdge());
+
+    for (size_t i=edgeBegin; i<edgeEnd; i++)
+      halfEdges[i].vtx_index = vertexIndices[i];
+
+    for (size_t i=edgeBegin; i<edgeEnd; i++)
+      if (!isHoleEdge(i)) keys.push_back(halfEdges[i].getEdge());
+
+    std::sort(keys.begin(),keys.end());
+    keys.erase(std::unique(keys.begin(),keys.end()),keys.end());
+
+    /* update keys of patched edges */
+    std::vector<KeyHalfEdge> modified;
+    modified.reserve(modifiedHalfEdges.size()+edgeEnd-edgeBegin);
+    for (const KeyHalfEdge& k : modifiedHalfEdges) {
+      const size_t i = k.edge-halfEdges.data();
+      if (i < edgeBegin || i >= edgeEnd) modified.push_back(k);
+    }
+    for (size_t i=edgeBegin; i<edgeEnd; i++)
+      if (!isHoleEdge(i)) modified.push_back(KeyHalfEdge(halfEdges[i].getEdge(),&halfEdges[i]));
+    std::sort(modified.begin(),modified.end());
+    modifiedHalfEdges = std::move(modified);
+
+    /* edges with changed adjacency and the edges following them get reset */
+    std::vector<HalfEdge*> edges;
+    for (const uint64_t key : keys)
+      findHalfEdges(key,edges);
+    for (size_t i=edgeBegin; i<edgeEnd; i++)
+      edges.push_back(&halfEdges[i]);
+    const size_t numAdjacentEdges = edges.size();
+    for (size_t i=0; i<numAdjacentEdges; i++)
+      edges.push_back(edges[i]->next());
+    std::sort(edges.begin(),edges.end());
+    edges.erase(std::unique(edges.begin(),edges.end()),edges.end());
+
+    /* relinking the edges of a reset edge and of its previous edge restores its state */
+    keys.clear();
+    for (const HalfEdge* edge : edges) {
+      if (!isHoleEdge(edge-halfEdges.data())) keys.push_back(edge->getEdge());
+      if (!isHoleEdge(edge->prev()-halfEdges.data())) keys.push_back(edge->prev()->getEdge());
+    }
+    std::sort(keys.begin(),keys.end());
+    keys.erase(std::unique(keys.begin(),keys.end()),keys.end());
+
+    /* reset edges to their state after creation */
+    parallel_for( size_t(0), edges.size(), blockSize, [&](const range<size_t>& r) 
+    {
+      for (size_t j=r.begin(); j<r.end(); j++)
+      {
+        HalfEdge* edge = edges[j];
+        const size_t e = edge-halfEdges.data();
+
+        /* we always have to use the geometry topology to lookup creases */
+        const unsigned int startVertex0 = mesh->topology[0].vertexIndices[e];
+        const unsigned int endVertex0 = mesh->topology[0].vertexIndices[e+edge->next_half_edge_ofs];
+        const uint64_t key0 = SubdivMesh::Edge(startVertex0,endVertex0);
+
+        edge->opposite_half_edge_ofs = 0;
+        edge->edge_crease_weight     = mesh->edgeCreaseMap->edgeCreaseMap.lookup(key0,0.0f);
+        edge->vertex_crease_weight   = mesh->vertexCreaseMap->vertexCreaseMap.lookup(startVertex0,0.0f);
+        edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
+        edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
+      }
+    });
+
+    /* link all adjacent edges again, edges that did not get reset are left unchanged */
+    parallel_for( size_t(0), keys.size(), blockSize, [&](const range<size_t>& r) 
+    {
+      std::vector<HalfEdge*> adjacent;
+      for (size_t j=r.begin(); j<r.end(); j++)
+      {
+        adjacent.clear();
+        findHalfEdges(keys[j],adjacent);
+        linkAdjacentHalfEdges(adjacent.size(),[&] (size_t i) { return adjacent[i]; });
+      }
+    });
+
+    /* the patch type and pinning of all faces around the vertices of reset edges may change */
+    std::vector<unsigned int> faces;
+    for (const HalfEdge* edge : edges)
+    {
+      bool border = false;
+      const HalfEdge* p = edge;
+      do {
+        faces.push_back(mesh->halfEdgeFace[p-halfEdges.data()]);
+        if (!p->hasOpposite()) { border = true; break; }
+        p = p->rotate();
+      } while (p != edge);
+
+      /* also walk into the other direction if the vertex has a border */
+      for (p = edge; border && p->prev()->hasOpposite(); ) {
+        p = p->prev()->opposite();
+        faces.push_back(mesh->halfEdgeFace[p-halfEdges.data()]);
+      }
+    }
+    std::sort(faces.begin(),faces.end());
+    faces.erase(std::unique(faces.begin(),faces.end()),faces.end());
+
+    parallel_for( size_t(0), faces.size(), blockSize, [&](const range<size_t>& r) 
+    {
+      for (size_t j=r.begin(); j<r.end(); j++)
+      {
+        const size_t f = faces[j];
+        const size_t e = mesh->faceStartEdge[f];
+
+        /* remove pinning of previous updates */
+        for (size_t i=0; i<mesh->faceVertices[f]; i++) {
+          if (halfEdges[e+i].vertex_type != HalfEdge::NON_MANIFOLD_EDGE_VERTEX)
+            halfEdges[e+i].vertex_crease_weight = mesh->vertexCreaseMap->vertexCreaseMap.lookup(mesh->topology[0].vertexIndices[e+i],0.0f);
+        }
+        updateFace(f);
+      }
+    });
+    
+    return true;
+  }
+
   void SubdivMesh::Topology::initializeHalfEdgeStructures ()
   {
     /* if vertex indices not set we ignore this topology */
@@ -640,16 +833,29 @@ namespace embree
     recalculate |= mesh->holes.isLocalModified();
 
     /* check if we can simply update the half edges */
-    bool update = false;
+    bool updateCreasesOrLevels = false;
+    updateCreasesOrLevels |= mesh->edge_creases.isLocalModified();
+    updateCreasesOrLevels |= mesh->edge_crease_weights.isLocalModified();
+    updateCreasesOrLevels |= mesh->vertex_creases.isLocalModified();
+    updateCreasesOrLevels |= mesh->vertex_crease_weights.isLocalModified(); 
+    updateCreasesOrLevels |= mesh->levels.isLocalModified();
+    bool update = updateCreasesOrLevels;
     update |= mesh->topology[0].vertexIndices.isLocalModified(); // we use this buffer to copy creases to interpolation topologies
-    update |= mesh->edge_creases.isLocalModified();
-    update |= mesh->edge_crease_weights.isLocalModified();
-    update |= mesh->vertex_creases.isLocalModified();
-    update |= mesh->vertex_crease_weights.isLocalModified(); 
-    update |= mesh->levels.isLocalModified();
+
+    /* check if we can patch the faces of a modified index range only */
+    bool incremental = recalculate;
+    incremental &= !mesh->faceVertices.isLocalModified();
+    incremental &= !mesh->holes.isLocalModified();
+    incremental &= !updateCreasesOrLevels;
+
+    size_t begin = 0, end = 0;
+    incremental = incremental && vertexIndices.getModifiedRange(vertexIndicesModCounter,begin,end);
 
     /* now either recalculate or update the half edges */
-    if (recalculate) calculateHalfEdges();
+    if (recalculate) {
+      if (!incremental || !updateHalfEdgesIncremental(begin,end))
+        calculateHalfEdges();
+    }
     else if (update) updateHalfEdges();
    
     /* cleanup some state for static scenes */
@@ -661,6 +867,8 @@ namespace embree
 
     /* clear modified state of all buffers */
     vertexIndices.clearLocalModified(); 
+    vertexIndices.clearModifiedRange();
+    vertexIndicesModCounter = vertexIndices.getModCounter();
   }
 
   void SubdivMesh::printStatistics()
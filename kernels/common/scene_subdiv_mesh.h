@@ -63,6 +63,7 @@ namespace embree
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
     void* getBufferData(RTCBufferType type, unsigned int slot, BufferDataPointerType pointerType);
     void updateBuffer(RTCBufferType type, unsigned int slot);
+    void updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end);
     void setTessellationRate(float N);
     bool verify();
     void commit();
@@ -139,7 +140,7 @@ namespace embree
     public:
 
       /*! Default topology construction */
-      Topology () : halfEdges(nullptr,0) {}
+      Topology () : halfEdges(nullptr,0), vertexIndicesModCounter(0) {}
 
       /*! Topology initialization */
       Topology (SubdivMesh* mesh);
@@ -152,7 +153,9 @@ namespace embree
           subdiv_mode(std::move(other.subdiv_mode)),
           halfEdges(std::move(other.halfEdges)),
           halfEdges0(std::move(other.halfEdges0)),
-          halfEdges1(std::move(other.halfEdges1)) {}
+          halfEdges1(std::move(other.halfEdges1)),
+          modifiedHalfEdges(std::move(other.modifiedHalfEdges)),
+          vertexIndicesModCounter(other.vertexIndicesModCounter) {}
       
       Topology& operator= (Topology&& other) // FIXME: this is only required to workaround compilation issues under Windows
       {
@@ -162,6 +165,8 @@ namespace embree
         halfEdges = std::move(other.halfEdges);
         halfEdges0 = std::move(other.halfEdges0);
         halfEdges1 = std::move(other.halfEdges1);
+        modifiedHalfEdges = std::move(other.modifiedHalfEdges);
+        vertexIndicesModCounter = other.vertexIndicesModCounter;
         return *this;
       }
 
@@ -194,6 +199,19 @@ namespace embree
       
       /*! updates half edges when recalculation is not necessary */
       void updateHalfEdges();
+
+      /*! patches the half edges of all faces affected by the modified
+       *  index range [begin,end), returns false if a recalculation is required */
+      bool updateHalfEdgesIncremental(size_t begin, size_t end);
+
+      /*! calculates validity, pinned vertices, and patch type of face f */
+      void updateFace(size_t f);
+
+      /*! returns true if the i'th half edge belongs to a hole */
+      bool isHoleEdge(size_t i) const;
+
+      /*! appends all half edges with the specified key */
+      void findHalfEdges(uint64_t key, std::vector<HalfEdge*>& edges) const;
       
       /*! user input data */
     public:
@@ -221,9 +239,16 @@ namespace embree
        *  half edge structure and can be cleared for static scenes */
     private:
       
-      /*! two arrays used to sort the half edges */
+      /*! two arrays used to sort the half edges, halfEdges1 is kept
+       *  sorted to find adjacent edges during incremental updates */
       std::vector<KeyHalfEdge> halfEdges0;
       std::vector<KeyHalfEdge> halfEdges1;
+
+      /*! sorted keys of half edges patched since the last recalculation */
+      std::vector<KeyHalfEdge> modifiedHalfEdges;
+
+      /*! modification counter of the index buffer at the last half edge update */
+      unsigned int vertexIndicesModCounter;
     };
 
     /*! returns the start half edge for topology t and face f */
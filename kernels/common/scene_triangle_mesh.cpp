@@ -134,6 +134,22 @@ namespace embree
     Geometry::update();
   }
 
+  void TriangleMesh::updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end)
+  {
+    if (type != RTC_BUFFER_TYPE_VERTEX) {
+      updateBuffer(type,slot);
+      return;
+    }
+
+    if (slot >= vertices.size())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer slot");
+    if (begin > end || end > vertices[slot].size())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer range");
+    vertices[slot].setModified(begin,end);
+
+    Geometry::update();
+  }
+
   void TriangleMesh::commit()
   {
     /* verify that stride of all time steps are identical */
@@ -146,6 +162,14 @@ namespace embree
     Geometry::commit();
   }
 
+  void TriangleMesh::postCommit()
+  {
+    /* refit builders only get modified vertex ranges of the last scene commit */
+    for (auto& buffer : vertices)
+      buffer.clearModifiedRange();
+    Geometry::postCommit();
+  }
+
   void TriangleMesh::addElementsToCount (GeometryCounts & counts) const 
   {
     if (numTimeSteps == 1) counts.numTriangles += numPrimitives;
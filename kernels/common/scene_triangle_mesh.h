@@ -38,7 +38,9 @@ namespace embree
     virtual void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num) override;
     virtual void* getBufferData(RTCBufferType type, unsigned int slot, BufferDataPointerType pointerType) override;
     virtual void updateBuffer(RTCBufferType type, unsigned int slot) override;
+    virtual void updateBufferRange(RTCBufferType type, unsigned int slot, size_t begin, size_t end) override;
     virtual void commit() override;
+    virtual void postCommit() override;
     virtual bool verify() override;
     virtual void interpolate(const RTCInterpolateArguments* const args) override;
     virtual void addElementsToCount (GeometryCounts & counts) const override;
@@ -90,6 +90,12 @@ namespace embree
     max_triangles_per_leaf = inf;
 
     tessellation_cache_size = 128*1024*1024;
+    tessellation_cache_lru = false;
+    accel_cache_dir = "";
+    incremental_build = false;
+    bvh_optimize_passes = -1;
+    fine_binning_threshold = -1;
+    build_memory_budget = 0;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -110,6 +116,7 @@ namespace embree
     scene_flags = -1;
     verbose = 0;
     benchmark = 0;
+    traversal_statistics = 0;
 
     numThreads = 0;
     numUserThreads = 0;
@@ -120,6 +127,7 @@ namespace embree
     set_affinity = false;
 #endif
 
+    numa = true;
     start_threads = false;
     enable_selockmemoryprivilege = false;
 #if defined(__LINUX__)
@@ -133,6 +141,8 @@ namespace embree
     alloc_num_main_slots = 0;
     alloc_thread_block_size = 0;
     alloc_single_thread_alloc = -1;
+    alloc_arena = false;
+    alloc_arena_dir = "";
 
     error_function = nullptr;
     error_function_userptr = nullptr;
@@ -270,6 +280,9 @@ namespace embree
       
       else if (tok == Token::Id("start_threads")&& cin->trySymbol("=")) 
         start_threads = cin->get().Int();
+
+      else if (tok == Token::Id("numa")&& cin->trySymbol("=")) 
+        numa = cin->get().Int();
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa_str = toLowerCase(cin->get().Identifier());
@@ -408,6 +421,8 @@ namespace embree
         verbose = cin->get().Int();
       else if (tok == Token::Id("benchmark") && cin->trySymbol("="))
         benchmark = cin->get().Int();
+      else if (tok == Token::Id("traversal_statistics") && cin->trySymbol("="))
+        traversal_statistics = max(0,cin->get().Int());
       
       else if (tok == Token::Id("quality")) {
         if (cin->trySymbol("=")) {
@@ -443,6 +458,26 @@ namespace embree
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_mode") && cin->trySymbol("=")) {
+        std::string mode = cin->get().Identifier();
+        if      (mode == "segmented") tessellation_cache_lru = false;
+        else if (mode == "lru"      ) tessellation_cache_lru = true;
+      }
+
+      else if (tok == Token::Id("accel_cache_dir") && cin->trySymbol("="))
+        accel_cache_dir = cin->get().String();
+
+      else if (tok == Token::Id("incremental_build") && cin->trySymbol("="))
+        incremental_build = cin->get().Int();
+
+      else if (tok == Token::Id("bvh_optimize_passes") && cin->trySymbol("="))
+        bvh_optimize_passes = cin->get().Int();
+
+      else if (tok == Token::Id("fine_binning_threshold") && cin->trySymbol("="))
+        fine_binning_threshold = cin->get().Int();
+
+      else if (tok == Token::Id("build_memory_budget") && cin->trySymbol("="))
+        build_memory_budget = size_t(cin->get().Float()*1024.0f*1024.0f);
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -452,6 +487,10 @@ namespace embree
          alloc_thread_block_size = cin->get().Int();
        else if (tok == Token::Id("alloc_single_thread_alloc") && cin->trySymbol("="))
          alloc_single_thread_alloc = cin->get().Int();
+       else if (tok == Token::Id("alloc_arena") && cin->trySymbol("="))
+         alloc_arena = cin->get().Int();
+       else if (tok == Token::Id("alloc_arena_dir") && cin->trySymbol("="))
+         alloc_arena_dir = cin->get().String();
 
       cin->trySymbol(","); // optional , separator
     }
@@ -468,6 +507,7 @@ namespace embree
     std::cout << "  build user threads = " << numUserThreads   << std::endl;
     std::cout << "  start_threads      = " << start_threads << std::endl;
     std::cout << "  affinity           = " << set_affinity << std::endl;
+    std::cout << "  numa               = " << numa << " (" << getNumberOfNUMANodes() << " nodes)" << std::endl;
     std::cout << "  frequency_level    = ";
     switch (frequency_level) {
     case FREQUENCY_SIMD128: std::cout << "simd128" << std::endl; break;
@@ -480,10 +520,23 @@ namespace embree
     if (!hugepages) std::cout << "disabled" << std::endl;
     else if (hugepages_success) std::cout << "enabled" << std::endl;
     else std::cout << "failed" << std::endl;
+    std::cout << "  alloc_arena        = " << alloc_arena << std::endl;
+    std::cout << "  alloc_arena_dir    = " << (alloc_arena_dir.empty() ? "disabled" : alloc_arena_dir) << std::endl;
 
     std::cout << "  verbosity          = " << verbose << std::endl;
+    std::cout << "  traversal_statistics = ";
+    if (traversal_statistics) std::cout << "every " << traversal_statistics << ". query" << std::endl;
+    else std::cout << "disabled" << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  cache_mode         = " << (tessellation_cache_lru ? "lru" : "segmented") << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  accel_cache_dir    = " << (accel_cache_dir.empty() ? "disabled" : accel_cache_dir) << std::endl;
+    std::cout << "  incremental_build  = " << incremental_build << std::endl;
+    std::cout << "  bvh_optimize_passes = " << bvh_optimize_passes << std::endl;
+    std::cout << "  fine_binning_threshold = " << fine_binning_threshold << std::endl;
+    std::cout << "  build_memory_budget = ";
+    if (build_memory_budget) std::cout << float(build_memory_budget)*1E-6 << " MB" << std::endl;
+    else std::cout << "unlimited" << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
@@ -117,6 +117,12 @@ namespace embree
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    bool tessellation_cache_lru;           //!< evict least recently used patches from the tessellation cache instead of whole segments
+    std::string accel_cache_dir;           //!< directory to store and load static BVHs, caching is disabled if empty
+    bool incremental_build;                //!< medium quality triangle and quad scenes only rebuild modified geometries on commit
+    int bvh_optimize_passes;               //!< number of treelet optimization passes after SAH builds, -1 optimizes high quality builds only
+    int fine_binning_threshold;            //!< SAH builds bin subtrees of at least that many primitives coarse-to-fine, 0 disables, -1 refines high quality builds only
+    size_t build_memory_budget;            //!< maximal bytes of primrefs of static SAH builds, larger scenes are built in chunks, 0 is unlimited
     size_t max_triangles_per_leaf;
 
   public:
@@ -132,11 +138,13 @@ namespace embree
     int scene_flags;
     size_t verbose;                        //!< verbosity of output
     size_t benchmark;                      //!< true
+    size_t traversal_statistics;           //!< every that many ray queries of a thread gather traversal statistics, 0 disables them
     
   public:
     size_t numThreads;                     //!< number of threads to use in builders
     size_t numUserThreads;                 //!< number of user provided threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
+    bool numa;                             //!< NUMA aware work stealing and allocation on multi socket systems
     bool start_threads;                    //!< true when threads should be started at device creation time
     int enabled_cpu_features;              //!< CPU ISA features to use
     int enabled_builder_cpu_features;      //!< CPU ISA features to use for builders only
@@ -154,6 +162,8 @@ namespace embree
     int alloc_num_main_slots;              //!< number of such shared blocks to be used to allocate
     size_t alloc_thread_block_size;        //!< size of thread local allocator block size
     int alloc_single_thread_alloc;         //!< in single mode nodes and leaves use same thread local allocator
+    bool alloc_arena;                      //!< reserve a single lazily committed memory range per static BVH
+    std::string alloc_arena_dir;           //!< directory of temporary files backing the arena, uses anonymous memory if empty
 
   public:
 
@@ -0,0 +1,79 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "traversal_statistics.h"
+
+namespace embree
+{
+  static std::atomic<size_t> traversal_statistics_next_id(1);
+
+  /* the counters of the statistics object the thread used last */
+  static __thread size_t thread_statistics_id = 0;
+  static __thread void* thread_statistics_counters = nullptr;
+
+  TraversalStatistics::TraversalStatistics ()
+    : samplingRate(0), id(traversal_statistics_next_id++) {}
+
+  TraversalStatistics::ThreadCounters* TraversalStatistics::threadCounters()
+  {
+    if (likely(thread_statistics_id == id))
+      return (ThreadCounters*) thread_statistics_counters;
+
+    /* the IDs are never reused, thus the cache never returns counters of a destroyed object */
+    ThreadCounters* counters = nullptr;
+    {
+      Lock<MutexSys> lock(mutex);
+      const std::thread::id owner = std::this_thread::get_id();
+      for (auto& thread : threads)
+        if (thread->owner == owner) counters = thread.get();
+
+      if (counters == nullptr) {
+        counters = new ThreadCounters(owner);
+        threads.push_back(std::unique_ptr<ThreadCounters>(counters));
+      }
+    }
+    thread_statistics_id = id;
+    thread_statistics_counters = counters;
+    return counters;
+  }
+
+  TraversalStatistics::Counters* TraversalStatistics::sample(QueryType type, size_t numRays)
+  {
+    ThreadCounters* thread = threadCounters();
+    Counters& counters = thread->counters[type];
+    Counters::add(counters.rays,numRays);
+    const size_t query = thread->queries.load(std::memory_order_relaxed);
+    thread->queries.store(query+1,std::memory_order_relaxed);
+    if (query % samplingRate != 0)
+      return nullptr;
+
+    Counters::add(counters.sampledRays,numRays);
+    return &counters;
+  }
+
+  void TraversalStatistics::get(QueryType type, Counters& counters_o)
+  {
+    counters_o.clear();
+    Lock<MutexSys> lock(mutex);
+    for (const auto& thread : threads)
+    {
+      const Counters& counters = thread->counters[type];
+      Counters::add(counters_o.rays,       counters.rays.load());
+      Counters::add(counters_o.sampledRays,counters.sampledRays.load());
+      Counters::add(counters_o.nodes,      counters.nodes.load());
+      Counters::add(counters_o.leaves,     counters.leaves.load());
+      Counters::add(counters_o.primitives, counters.primitives.load());
+      Counters::add(counters_o.filterCalls,counters.filterCalls.load());
+    }
+  }
+
+  void TraversalStatistics::clear()
+  {
+    Lock<MutexSys> lock(mutex);
+    for (auto& thread : threads) {
+      thread->queries.store(0);
+      for (size_t i=0; i<NUM_QUERY_TYPES; i++)
+        thread->counters[i].clear();
+    }
+  }
+}
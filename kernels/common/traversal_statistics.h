@@ -0,0 +1,154 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+#include <thread>
+
+namespace embree
+{
+  /*! Traversal statistics of a device gathered at runtime. Different to
+   *  the EMBREE_STAT_COUNTERS statistics these are available in release
+   *  builds and get enabled at device creation by specifying a sampling
+   *  rate N, only every N-th ray query of a thread is instrumented. Each
+   *  thread accumulates into its own counters, thus queries of different
+   *  threads never contend. */
+  class TraversalStatistics
+  {
+  public:
+
+    enum QueryType
+    {
+      INTERSECT = 0,
+      OCCLUDED  = 1,
+      NUM_QUERY_TYPES = 2
+    };
+
+    /*! counters of one query type, only written by the owning thread */
+    struct Counters
+    {
+      Counters () {
+        clear();
+      }
+
+      void clear()
+      {
+        rays.store(0);
+        sampledRays.store(0);
+        nodes.store(0);
+        leaves.store(0);
+        primitives.store(0);
+        filterCalls.store(0);
+      }
+
+      /*! the owning thread is the only writer, thus no atomic read-modify-write is required */
+      __forceinline static void add(std::atomic<size_t>& counter, size_t n) {
+        counter.store(counter.load(std::memory_order_relaxed)+n,std::memory_order_relaxed);
+      }
+
+      __forceinline void addTraversal(size_t numNodes, size_t numLeaves, size_t numPrimitives)
+      {
+        add(nodes,numNodes);
+        add(leaves,numLeaves);
+        add(primitives,numPrimitives);
+      }
+
+      __forceinline void addFilterCall() {
+        add(filterCalls,1);
+      }
+
+    public:
+      std::atomic<size_t> rays;         //!< number of rays traced
+      std::atomic<size_t> sampledRays;  //!< number of rays traced by sampled queries
+      std::atomic<size_t> nodes;        //!< number of inner nodes visited by sampled queries
+      std::atomic<size_t> leaves;       //!< number of leaves visited by sampled queries
+      std::atomic<size_t> primitives;   //!< number of primitive blocks intersected by sampled queries
+      std::atomic<size_t> filterCalls;  //!< number of filter function invocations of sampled queries
+    };
+
+  private:
+
+    struct __aligned(64) ThreadCounters
+    {
+      ALIGNED_STRUCT_(64);
+
+      ThreadCounters (std::thread::id owner)
+        : owner(owner), queries(0) {}
+
+      std::thread::id owner;              //!< thread the counters belong to
+      std::atomic<size_t> queries;        //!< number of queries of the thread, used for sampling
+      Counters counters[NUM_QUERY_TYPES];
+    };
+
+  public:
+
+    TraversalStatistics ();
+
+    /*! sets the sampling rate, 0 disables the statistics */
+    void setSamplingRate(size_t rate) {
+      samplingRate = rate;
+    }
+
+    /*! returns the sampling rate, 0 if the statistics are disabled */
+    __forceinline size_t getSamplingRate() const {
+      return samplingRate;
+    }
+
+    /*! starts a query of numRays rays, returns the counters to
+     *  accumulate into if the query got sampled and nullptr otherwise */
+    __forceinline Counters* beginQuery(QueryType type, size_t numRays)
+    {
+      if (likely(samplingRate == 0)) return nullptr;
+      return sample(type,numRays);
+    }
+
+    /*! starts a query of the valid rays of a packet of K rays */
+    __forceinline Counters* beginQuery(QueryType type, const int* valid, size_t K)
+    {
+      if (likely(samplingRate == 0)) return nullptr;
+      size_t numRays = 0;
+      for (size_t i=0; i<K; i++) numRays += valid[i] == -1;
+      return sample(type,numRays);
+    }
+
+    /*! sums up the counters of all threads */
+    void get(QueryType type, Counters& counters_o);
+
+    /*! clears the counters of all threads, must not be called concurrently to ray queries */
+    void clear();
+
+  private:
+    Counters* sample(QueryType type, size_t numRays);
+    ThreadCounters* threadCounters();
+
+  private:
+    size_t samplingRate;
+    size_t id;                                              //!< unique ID to identify the per thread counters of this object
+    MutexSys mutex;
+    std::vector<std::unique_ptr<ThreadCounters>> threads;  //!< counters of all threads that traced rays
+  };
+
+  /*! Counts the nodes, leaves and primitives visited by a single
+   *  traversal and adds them to the counters of the query if the
+   *  query got sampled. */
+  struct TraversalCounters
+  {
+    __forceinline TraversalCounters (TraversalStatistics::Counters* stats)
+      : stats(stats), nodes(0), leaves(0), primitives(0) {}
+
+    __forceinline ~TraversalCounters ()
+    {
+#if !defined(__SYCL_DEVICE_ONLY__)
+      if (unlikely(stats)) stats->addTraversal(nodes,leaves,primitives);
+#endif
+    }
+
+  public:
+    TraversalStatistics::Counters* stats;
+    size_t nodes;
+    size_t leaves;
+    size_t primitives;
+  };
+}
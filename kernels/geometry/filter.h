@@ -17,6 +17,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         geometry->intersectionFilterN(args);
+        context->countFilterCall();
 
         if (args->valid[0] == 0)
           return false;
@@ -24,8 +25,10 @@ namespace embree
 
       if (context->getFilter())
       {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          context->countFilterCall();
+        }
 
         if (args->valid[0] == 0)
           return false;
@@ -53,6 +56,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         geometry->occlusionFilterN(args);
+        context->countFilterCall();
 
         if (args->valid[0] == 0)
           return false;
@@ -60,8 +64,10 @@ namespace embree
 
       if (context->getFilter())
       {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          context->countFilterCall();
+        }
 
         if (args->valid[0] == 0)
           return false;
@@ -87,15 +93,19 @@ namespace embree
       __forceinline vbool<K> runIntersectionFilterHelper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       vint<K>* mask = (vint<K>*) args->valid;
-      if (geometry->intersectionFilterN)
+      if (geometry->intersectionFilterN) {
         geometry->intersectionFilterN(args);
+        context->countFilterCall();
+      }
       
       vbool<K> valid_o = *mask != vint<K>(zero);
       if (none(valid_o)) return valid_o;
 
       if (context->getFilter()) {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          context->countFilterCall();
+        }
       }
 
       valid_o = *mask != vint<K>(zero);
@@ -123,15 +133,19 @@ namespace embree
       __forceinline vbool<K> runOcclusionFilterHelper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       vint<K>* mask = (vint<K>*) args->valid;
-      if (geometry->occlusionFilterN)
+      if (geometry->occlusionFilterN) {
         geometry->occlusionFilterN(args);
+        context->countFilterCall();
+      }
       
       vbool<K> valid_o = *mask != vint<K>(zero);
       if (none(valid_o)) return valid_o;
 
       if (context->getFilter()) {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          context->countFilterCall();
+        }
       }
       valid_o = *mask != vint<K>(zero);
 
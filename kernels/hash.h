@@ -0,0 +1,4 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#define RTC_HASH "55c2e9e5b34674cc63c087c1184ce1eb2f23d07b"
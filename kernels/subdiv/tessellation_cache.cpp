@@ -17,7 +17,29 @@ namespace embree
     if (new_size >= SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
       new_size = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
     if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size) 
-      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size);    
+      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size,SharedLazyTessellationCache::sharedLazyTessellationCache.isLRU());
+  }
+
+  void setTessellationCacheLRU(bool lru)
+  {
+    if (SharedLazyTessellationCache::sharedLazyTessellationCache.isLRU() != lru)
+      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(SharedLazyTessellationCache::sharedLazyTessellationCache.getSize(),lru);
+  }
+
+  size_t getTessellationCacheSize() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getSize();
+  }
+
+  bool getTessellationCacheLRU() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.isLRU();
+  }
+
+  TessellationCacheCounters getTessellationCacheCounters() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getCounters();
+  }
+
+  void clearTessellationCacheCounters() {
+    SharedLazyTessellationCache::sharedLazyTessellationCache.clearCounters();
   }
 
   void resetTessellationCache()
@@ -42,6 +64,14 @@ namespace embree
 #endif
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
 
+    for (size_t i=0; i<NUM_CACHE_SEGMENTS; i++) segmentPatches[i] = 0;
+    evictions  = 0;
+    lru        = false;
+    numGroups  = 0;
+    freeGroups = INVALID_GROUP;
+    usedBlocks = 0;
+    lruEpoch   = 0;
+
     //reset_state.reset();
     //linkedlist_mtx.reset();
   }
@@ -56,6 +86,10 @@ namespace embree
     }
 
     delete[] threadWorkState;
+
+    for (size_t id=0; id<numGroups; id++) 
+      for (void* ptr : group(id).allocations) alignedFree(ptr);
+    for (PatchGroup* chunk : groupChunks) delete[] chunk;
   }
 
   void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
@@ -83,20 +117,34 @@ namespace embree
      }
    }
 
+  void SharedLazyTessellationCache::lockAllThreads()
+  {
+    /* lock the linked list of thread states */
+    linkedlist_mtx.lock();
+
+    /* block all threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
+        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+  }
+
+  void SharedLazyTessellationCache::unlockAllThreads()
+  {
+    /* release all blocked threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+
+    /* unlock the linked list of thread states */
+    linkedlist_mtx.unlock();
+  }
+
   void SharedLazyTessellationCache::allocNextSegment() 
   {
     if (reset_state.try_lock())
     {
       if (next_block >= switch_block_threshold)
       {
-        /* lock the linked list of thread states */
-        
-        linkedlist_mtx.lock();
-        
-        /* block all threads */
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-            waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+        lockAllThreads();
         
         /* switch to the next segment */
         addCurrentIndex();
@@ -111,19 +159,13 @@ namespace embree
         switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
         assert( switch_block_threshold <= maxBlocks );
 #endif
+
+        /* all patches of the reused segment got evicted */
+        evictions += segmentPatches[localTime % NUM_CACHE_SEGMENTS].exchange(0);
         
         CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
         
-        /* release all blocked threads */
-        
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-        
-        /* unlock the linked list of thread states */
-        
-        linkedlist_mtx.unlock();
-	
-        
+        unlockAllThreads();
       }
       reset_state.unlock();
     }
@@ -137,13 +179,7 @@ namespace embree
     /* lock the reset_state */
     reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    lockAllThreads();
 
     /* reset to the first segment */
     next_block = 0;
@@ -156,39 +192,40 @@ namespace embree
     /* reset local time */
     localTime = NUM_CACHE_SEGMENTS;
 
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+    /* drop all patches */
+    for (size_t i=0; i<NUM_CACHE_SEGMENTS; i++) segmentPatches[i] = 0;
+    clearGroups();
 
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    unlockAllThreads();
 
     /* unlock the reset_state */
     reset_state.unlock();
   }
 
-  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  void SharedLazyTessellationCache::realloc(const size_t new_size, const bool new_lru)
   {
     /* lock the reset_state */
     reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
+    lockAllThreads();
 
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
-
-    /* reallocate data */
+    /* reallocate data, the LRU mode allocates each patch separately */
     if (data) os_free(data,size,hugepages);
     size      = new_size;
     data      = nullptr;
-    if (size) data = (float*)os_malloc(size,hugepages);
+    if (size && !new_lru) data = (float*)os_malloc(size,hugepages);
     maxBlocks = size/BLOCK_SIZE;    
 
     /* invalidate entire cache */
     localTime += NUM_CACHE_SEGMENTS; 
+    for (size_t i=0; i<NUM_CACHE_SEGMENTS; i++) segmentPatches[i] = 0;
+    clearGroups();
+    lru = new_lru;
+
+    /* each cached group holds at least one block, additional groups are under construction or deferred */
+    const size_t maxGroupChunks = (maxBlocks+GROUP_CHUNK_SIZE-1)/GROUP_CHUNK_SIZE + MAX_GROUP_CHUNKS_EXTRA;
+    if (lru && groupChunks.capacity() < maxGroupChunks)
+      groupChunks.reserve(maxGroupChunks);
 
     /* reset to the first segment */
 #if FORCE_SIMPLE_FLUSH == 1
@@ -201,17 +238,220 @@ namespace embree
     assert( switch_block_threshold <= maxBlocks );
 #endif
 
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    unlockAllThreads();
 
     /* unlock the reset_state */
     reset_state.unlock();
   }
 
+  TessellationCacheCounters SharedLazyTessellationCache::getCounters()
+  {
+    TessellationCacheCounters counters;
+    counters.hits = 0;
+    counters.misses = 0;
+    counters.evictions = evictions;
+
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      counters.hits   += t->hits.load(std::memory_order_relaxed);
+      counters.misses += t->misses.load(std::memory_order_relaxed);
+    }
+    linkedlist_mtx.unlock();
+    return counters;
+  }
+
+  void SharedLazyTessellationCache::clearCounters()
+  {
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      t->hits.store(0,std::memory_order_relaxed);
+      t->misses.store(0,std::memory_order_relaxed);
+    }
+    evictions = 0;
+    linkedlist_mtx.unlock();
+  }
+
+  size_t SharedLazyTessellationCache::newGroup(const bool cached)
+  {
+    Lock<SpinLock> lock(groups_mtx);
+    size_t id = freeGroups;
+    if (id != INVALID_GROUP)
+      freeGroups = group(id).nextFree;
+    else
+    {
+      id = numGroups;
+      if (id % GROUP_CHUNK_SIZE == 0)
+      {
+        /* the chunk array may not grow as lookups access it concurrently */
+        if (groupChunks.size() == groupChunks.capacity())
+          throw_RTCError(RTC_ERROR_OUT_OF_MEMORY,"too many patches under construction in tessellation cache");
+        groupChunks.push_back(new PatchGroup[GROUP_CHUNK_SIZE]);
+      }
+      numGroups++;
+    }
+    
+    PatchGroup& g = group(id);
+    g.tag = 0;
+    g.entry = nullptr;
+    g.root = 0;
+    g.lastUse = 0;
+    g.blocks = 0;
+    g.cached = cached;
+    g.allocations.clear();
+    g.nextFree = INVALID_GROUP;
+    return id;
+  }
+
+  void SharedLazyTessellationCache::freeGroup(const size_t id)
+  {
+    PatchGroup& g = group(id);
+    for (void* ptr : g.allocations) alignedFree(ptr);
+    g.allocations.clear();
+    g.tag = 0;
+    usedBlocks -= g.blocks;
+    g.blocks = 0;
+
+    Lock<SpinLock> lock(groups_mtx);
+    g.nextFree = freeGroups;
+    freeGroups = id;
+  }
+
+  void SharedLazyTessellationCache::uncacheGroup(PatchGroup& g)
+  {
+    usedBlocks -= g.blocks;
+    g.blocks = 0;
+    g.cached = false;
+  }
+
+  void SharedLazyTessellationCache::beginGroup(ThreadWorkState* t_state)
+  {
+    /* the patch of the previous uncached construction is no longer in use */
+    if (t_state->deferred != INVALID_GROUP) {
+      freeGroup(t_state->deferred);
+      t_state->deferred = INVALID_GROUP;
+    }
+    if (t_state->group != INVALID_GROUP)
+      freeGroup(t_state->group);
+    
+    t_state->group = newGroup(true);
+  }
+
+  int64_t SharedLazyTessellationCache::endGroup(ThreadWorkState* t_state, const CacheEntry& entry, const size_t root, const size_t time)
+  {
+    PatchGroup& g = group(t_state->group);
+    if (!g.cached) {
+      deferGroup(t_state);
+      return 0;
+    }
+
+    const int64_t tag = int64_t(t_state->group+1) | (int64_t(time) << COMMIT_INDEX_SHIFT);
+    t_state->group = INVALID_GROUP;
+    g.entry = &entry;
+    g.root = root;
+    g.lastUse = lruEpoch.fetch_add(1)+1;
+    __memory_barrier();
+    g.tag = tag;
+    return tag;
+  }
+
+  void SharedLazyTessellationCache::deferGroup(ThreadWorkState* t_state)
+  {
+    /* the patch is in use until the thread unlocks, thus it gets freed with the next construction */
+    uncacheGroup(group(t_state->group));
+    assert(t_state->deferred == INVALID_GROUP);
+    t_state->deferred = t_state->group;
+    t_state->group = INVALID_GROUP;
+  }
+
+  void* SharedLazyTessellationCache::allocGroup(ThreadWorkState* t_state, const size_t bytes)
+  {
+    /* allocations of a construction that started in segmented mode are never cached */
+    if (unlikely(t_state->group == INVALID_GROUP)) {
+      if (t_state->deferred != INVALID_GROUP) {
+        freeGroup(t_state->deferred);
+        t_state->deferred = INVALID_GROUP;
+      }
+      t_state->group = newGroup(false);
+    }
+    
+    PatchGroup& g = group(t_state->group);
+    const size_t blocks = (bytes+BLOCK_SIZE-1)/BLOCK_SIZE;
+    while (g.cached)
+    {
+      if (usedBlocks.fetch_add(blocks)+blocks <= maxBlocks) {
+        g.blocks += blocks;
+        break;
+      }
+      usedBlocks.fetch_sub(blocks);
+
+      unlockThread(t_state);
+      const bool success = evictGroups(blocks);
+      lockThreadLoop(t_state);
+
+      /* the budget is held by other constructions, thus the patch is used once without caching it */
+      if (!success) uncacheGroup(g);
+    }
+    
+    void* ptr = alignedMalloc(blocks*BLOCK_SIZE,BLOCK_SIZE);
+    g.allocations.push_back(ptr);
+    return ptr;
+  }
+
+  bool SharedLazyTessellationCache::evictGroups(const size_t blocks)
+  {
+    bool success = true;
+    if (reset_state.try_lock())
+    {
+      if (usedBlocks+blocks > maxBlocks)
+      {
+        lockAllThreads();
+        success = evictLeastRecentlyUsed(blocks);
+        unlockAllThreads();
+      }
+      reset_state.unlock();
+    }
+    else
+      reset_state.wait_until_unlocked();
+    return success;
+  }
+
+  bool SharedLazyTessellationCache::evictLeastRecentlyUsed(const size_t blocks)
+  {
+    /* like a segment switch, evict a fraction of the budget at once to amortize blocking all threads */
+    const size_t reserve = blocks + maxBlocks/NUM_CACHE_SEGMENTS;
+    const size_t target = maxBlocks > reserve ? maxBlocks-reserve : 0;
+
+    std::vector<std::pair<size_t,size_t>> cached;
+    for (size_t id=0; id<numGroups; id++) {
+      PatchGroup& g = group(id);
+      if (g.tag != 0) cached.push_back(std::make_pair(g.lastUse.load(),id));
+    }
+    std::sort(cached.begin(),cached.end());
+
+    for (size_t i=0; i<cached.size() && usedBlocks > target; i++) {
+      freeGroup(cached[i].second);
+      evictions++;
+    }
+    return usedBlocks+blocks <= maxBlocks;
+  }
+
+  void SharedLazyTessellationCache::clearGroups()
+  {
+    /* constructions in progress continue without caching their patch */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+    {
+      if (t->deferred != INVALID_GROUP) {
+        freeGroup(t->deferred);
+        t->deferred = INVALID_GROUP;
+      }
+      if (t->group != INVALID_GROUP)
+        uncacheGroup(group(t->group));
+    }
+    
+    for (size_t id=0; id<numGroups; id++)
+      if (group(id).tag != 0) freeGroup(id);
+  }
+
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
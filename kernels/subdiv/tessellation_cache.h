@@ -34,8 +34,21 @@ namespace embree
     static void clearStats();
   };
   
+  /*! counters of the shared tessellation cache */
+  struct TessellationCacheCounters
+  {
+    size_t hits;       //!< number of lookups served from the cache
+    size_t misses;     //!< number of lookups that constructed a patch
+    size_t evictions;  //!< number of cached patches dropped to make space for new ones
+  };
+
   void resizeTessellationCache(size_t new_size);
   void resetTessellationCache();
+  void setTessellationCacheLRU(bool lru);
+  size_t getTessellationCacheSize();
+  bool getTessellationCacheLRU();
+  TessellationCacheCounters getTessellationCacheCounters();
+  void clearTessellationCacheCounters();
   
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
@@ -49,8 +62,13 @@ namespace embree
    ThreadWorkState* next;
    bool allocated;
 
+   std::atomic<size_t> hits;    //!< number of lookups of this thread served from the cache
+   std::atomic<size_t> misses;  //!< number of lookups of this thread that constructed a patch
+   size_t group;                //!< patch group under construction in LRU mode
+   size_t deferred;             //!< uncached patch group that is freed with the next construction
+
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), next(nullptr), allocated(allocated), hits(0), misses(0), group(-1), deferred(-1)
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
@@ -70,6 +88,9 @@ namespace embree
 #endif
    static const size_t MAX_TESSELLATION_CACHE_SIZE     = REF_TAG_MASK+1;
    static const size_t BLOCK_SIZE                      = 64;
+   static const size_t GROUP_CHUNK_SIZE                = 1024;
+   static const size_t MAX_GROUP_CHUNKS_EXTRA          = 64;
+   static const size_t INVALID_GROUP                   = (size_t)-1;
    
 
     /*! Per thread tessellation ref cache */
@@ -125,6 +146,21 @@ namespace embree
      SpinLock mutex;
    };
 
+   /*! In LRU mode all allocations of a patch are a group that gets
+    *  evicted as a whole. The tag of a cache entry stores the index
+    *  of the group instead of an offset into the cache memory. */
+   struct PatchGroup
+   {
+     std::atomic<int64_t> tag;       //!< tag that references this group, 0 if the group is not cached
+     const CacheEntry* entry;        //!< cache entry the group got constructed for
+     size_t root;                    //!< value returned by the constructor
+     std::atomic<size_t> lastUse;    //!< epoch of the most recent lookup
+     size_t blocks;                  //!< number of blocks charged to the budget
+     bool cached;                    //!< false if the group did not fit into the budget
+     std::vector<void*> allocations; //!< memory of the group
+     size_t nextFree;                //!< next group of the free list
+   };
+
  private:
 
    float *data;
@@ -140,6 +176,19 @@ namespace embree
    __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
 
+   /* patches constructed per segment, counted as evictions when the segment gets reused */
+   __aligned(64) std::atomic<size_t> segmentPatches[NUM_CACHE_SEGMENTS];
+   __aligned(64) std::atomic<size_t> evictions;
+
+   /* state of the LRU mode */
+   bool lru;
+   std::vector<PatchGroup*> groupChunks;
+   __aligned(64) std::atomic<size_t> numGroups;
+   size_t freeGroups;
+   __aligned(64) SpinLock groups_mtx;
+   __aligned(64) std::atomic<size_t> usedBlocks;
+   __aligned(64) std::atomic<size_t> lruEpoch;
+
 
  public:
 
@@ -200,11 +249,17 @@ namespace embree
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
-       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
        if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
        {
+         if (unlikely(sharedLazyTessellationCache.lru)) {
+           void* patch = sharedLazyTessellationCache.lookupGroup(entry,subdiv_patch_root_ref);
+           CACHE_STATS(if (patch) SharedTessellationCacheStats::cache_hits++; else SharedTessellationCacheStats::cache_misses++);
+           return patch;
+         }
+         
+         const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
          CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
          return (void*) subdiv_patch_root;
        }
@@ -222,12 +277,18 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         count(t_state->hits);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
-         if (!validTag(entry.tag,globalTime)) 
+         if (!SharedLazyTessellationCache::lookup(entry,globalTime)) 
          {
+           count(t_state->misses);
+           const bool lru = sharedLazyTessellationCache.lru;
+           if (lru) sharedLazyTessellationCache.beginGroup(t_state);
            auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
@@ -235,7 +296,17 @@ namespace embree
            auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
            auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
-           entry.tag = SharedLazyTessellationCache::Tag(ret,time);
+           if (lru)
+             entry.tag.set(sharedLazyTessellationCache.endGroup(t_state,entry,(size_t)ret,time));
+           else if (unlikely(t_state->group != INVALID_GROUP)) {
+             /* the cache switched to LRU mode during construction */
+             sharedLazyTessellationCache.deferGroup(t_state);
+             entry.tag.reset();
+           }
+           else {
+             entry.tag = SharedLazyTessellationCache::Tag(ret,time);
+             sharedLazyTessellationCache.segmentPatches[sharedLazyTessellationCache.getCurrentIndex() % NUM_CACHE_SEGMENTS]++;
+           }
            __memory_barrier();
            entry.mutex.unlock();
            return ret;
@@ -287,6 +358,9 @@ namespace embree
    {
      size_t block_index = -1;
      ThreadWorkState *const t_state = threadState();
+     if (unlikely(t_state->group != INVALID_GROUP || sharedLazyTessellationCache.lru))
+       return sharedLazyTessellationCache.allocGroup(t_state,bytes);
+     
      while (true)
      {
        block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
@@ -316,10 +390,56 @@ namespace embree
    __forceinline size_t getSize()         { return size; }
 
    void allocNextSegment();
-   void realloc(const size_t newSize);
+   void realloc(const size_t newSize, const bool newLRU);
 
    void reset();
 
+   __forceinline bool isLRU() const { return lru; }
+
+   TessellationCacheCounters getCounters();
+   void clearCounters();
+
+   /* increments a counter that only the owning thread modifies */
+   static __forceinline void count(std::atomic<size_t>& counter) {
+     counter.store(counter.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+   }
+
+   /* LRU mode */
+   __forceinline PatchGroup& group(const size_t id) {
+     return groupChunks[id/GROUP_CHUNK_SIZE][id%GROUP_CHUNK_SIZE];
+   }
+
+   __forceinline void* lookupGroup(const CacheEntry& entry, const int64_t ref)
+   {
+     const size_t id = size_t(ref & REF_TAG_MASK)-1;
+     if (unlikely(id >= numGroups.load())) return nullptr;
+     PatchGroup& g = group(id);
+     if (g.tag.load() != ref || g.entry != &entry) return nullptr;
+
+     /* only write the epoch if it changed to not share the cache line of hot patches */
+     const size_t epoch = lruEpoch.load(std::memory_order_relaxed);
+     if (g.lastUse.load(std::memory_order_relaxed) != epoch)
+       g.lastUse.store(epoch,std::memory_order_relaxed);
+     return (void*) g.root;
+   }
+
+   void beginGroup(ThreadWorkState* t_state);
+   int64_t endGroup(ThreadWorkState* t_state, const CacheEntry& entry, const size_t root, const size_t time);
+   void deferGroup(ThreadWorkState* t_state);
+   void* allocGroup(ThreadWorkState* t_state, const size_t bytes);
+
+ private:
+   size_t newGroup(const bool cached);
+   void freeGroup(const size_t id);
+   void uncacheGroup(PatchGroup& g);
+   bool evictGroups(const size_t blocks);
+   bool evictLeastRecentlyUsed(const size_t blocks);
+   void clearGroups();
+   void lockAllThreads();
+   void unlockAllThreads();
+
+ public:
+
    static SharedLazyTessellationCache sharedLazyTessellationCache;
  };
 }
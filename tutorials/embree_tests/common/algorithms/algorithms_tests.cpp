@@ -6,6 +6,8 @@
 #include "parallel_for.cpp"
 #include "parallel_for_for.cpp"
 #include "parallel_for_for_prefix_sum.cpp"
+#include "parallel_hash_map.cpp"
+#include "parallel_hash_set.cpp"
 #include "parallel_map.cpp"
 #include "parallel_partition.cpp"
 #include "parallel_prefix_sum.cpp"
@@ -16,7 +16,7 @@ namespace parallel_any_of_unit_tests {
 TEST_CASE ("Test parallel_any_of", "[parallel_any_of]")
 {
   const size_t num_threads = std::thread::hardware_concurrency();
-  TaskScheduler::create(num_threads, true, false);
+  TaskScheduler::create(num_threads, true, false, false);
 
   std::vector<int> data(1024);
   std::iota(data.begin(), data.end(), 0);
@@ -0,0 +1,65 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../../external/catch.hpp"
+#include "../common/tasking/taskscheduler.h"
+#include "../common/algorithms/parallel_hash_map.h"
+
+#include <thread>
+
+using namespace embree;
+
+namespace parallel_hash_map_unit_test {
+
+template<typename Key>
+bool test_parallel_hash_map(const size_t N)
+{
+  bool passed = true;
+
+  /* create key/value vectors with random numbers, the last key is also used to mark empty slots */
+  std::vector<Key> keys(N);
+  std::vector<uint32_t> vals(N);
+  for (size_t i=0; i<N; i++) keys[i] = 2*Key(i)*Key(647382649);
+  for (size_t i=0; i<N; i++) std::swap(keys[i],keys[rand()%N]);
+  for (size_t i=0; i<N; i++) vals[i] = 2*rand();
+  keys[N-1] = Key(-1);
+
+  /* create map */
+  parallel_hash_map<Key,uint32_t> map;
+  map.init(keys,vals);
+
+  /* check that all keys are properly mapped */
+  for (size_t i=0; i<N; i++) {
+    const uint32_t* val = map.lookup(keys[i]);
+    passed &= val && (*val == vals[i]);
+    passed &= map.lookup(keys[i],1) == vals[i];
+  }
+
+  /* check that these keys are not in the map */
+  for (size_t i=0; i<N-1; i++) {
+    passed &= !map.lookup(keys[i]+1);
+    passed &= map.lookup(keys[i]+1,1) == 1;
+  }
+
+  /* check that the map is empty after clearing */
+  map.clear();
+  for (size_t i=0; i<N; i++)
+    passed &= !map.lookup(keys[i]);
+
+  return passed;
+}
+
+TEST_CASE("Test parallel_hash_map", "[parallel_hash_map]")
+{
+  const size_t num_threads = std::thread::hardware_concurrency();
+  TaskScheduler::create(num_threads, true, false, false);
+
+  REQUIRE(test_parallel_hash_map<uint32_t>(10));
+  REQUIRE(test_parallel_hash_map<uint32_t>(10000));
+  REQUIRE(test_parallel_hash_map<uint32_t>(1000000));
+  REQUIRE(test_parallel_hash_map<uint64_t>(10));
+  REQUIRE(test_parallel_hash_map<uint64_t>(10000));
+  REQUIRE(test_parallel_hash_map<uint64_t>(1000000));
+}
+
+}
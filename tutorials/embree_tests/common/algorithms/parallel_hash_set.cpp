@@ -0,0 +1,53 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../../external/catch.hpp"
+#include "../common/tasking/taskscheduler.h"
+#include "../common/algorithms/parallel_hash_set.h"
+
+#include <thread>
+
+using namespace embree;
+
+namespace parallel_hash_set_unit_test {
+
+template<typename T>
+bool test_parallel_hash_set(const size_t N)
+{
+  bool passed = true;
+
+  /* create vector with random numbers, including duplicates */
+  std::vector<T> unsorted(N);
+  for (size_t i=0; i<N; i++) unsorted[i] = 2*((T(rand()) << (8*sizeof(T)-32)) ^ T(rand()));
+
+  /* created set from numbers */
+  parallel_hash_set<T> set;
+  set.init(unsorted);
+
+  /* check that all elements are in the set */
+  for (size_t i=0; i<N; i++) {
+    passed &= set.lookup(unsorted[i]);
+  }
+
+  /* check that these elements are not in the set */
+  for (size_t i=0; i<N; i++) {
+    passed &= !set.lookup(unsorted[i]+1);
+  }
+  passed &= !set.lookup(T(-1));
+
+  return passed;
+}
+
+TEST_CASE("Test parallel_hash_set", "[parallel_hash_set]")
+{
+  const size_t num_threads = std::thread::hardware_concurrency();
+  TaskScheduler::create(num_threads, true, false, false);
+
+  REQUIRE(test_parallel_hash_set<uint32_t>(0));
+  REQUIRE(test_parallel_hash_set<uint32_t>(10000));
+  REQUIRE(test_parallel_hash_set<uint32_t>(1000000));
+  REQUIRE(test_parallel_hash_set<uint64_t>(10000));
+  REQUIRE(test_parallel_hash_set<uint64_t>(1000000));
+}
+
+}
@@ -2,3 +2,4 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "algorithms/algorithms_tests.cpp"
+#include "tasking/tasking_tests.cpp"
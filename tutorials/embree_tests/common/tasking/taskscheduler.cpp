@@ -0,0 +1,62 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../../external/catch.hpp"
+#include "../common/tasking/taskscheduler.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace embree;
+
+namespace taskscheduler_unit_tests {
+
+#if defined(TASKING_INTERNAL) && !defined(TASKING_TBB)
+
+TEST_CASE ("Test wide task trees", "[taskscheduler]")
+{
+  const size_t num_threads = std::thread::hardware_concurrency();
+  TaskScheduler::create(num_threads, true, false, false);
+
+  /* spawn more tasks from a single task than fit into one segment of the task deque */
+  const size_t N = 4*TaskScheduler::TASK_SEGMENT_SIZE+1;
+  std::atomic<size_t> counter(0);
+  TaskScheduler::TaskGroupContext context;
+  TaskScheduler::spawn([&]() {
+      for (size_t i=0; i<N; i++)
+        TaskScheduler::spawn([&]() { counter++; },&context);
+      TaskScheduler::wait();
+    },&context);
+  TaskScheduler::wait();
+
+  REQUIRE(context.cancellingException == nullptr);
+  REQUIRE(counter == N);
+}
+
+TEST_CASE ("Test large task closures", "[taskscheduler]")
+{
+  const size_t num_threads = std::thread::hardware_concurrency();
+  TaskScheduler::create(num_threads, true, false, false);
+
+  /* spawn more closure data than fits into one block of the closure arena */
+  struct Payload { size_t data[128]; };
+  Payload payload;
+  for (size_t i=0; i<128; i++) payload.data[i] = i;
+
+  const size_t N = 4*TaskScheduler::CLOSURE_BLOCK_SIZE/sizeof(Payload);
+  std::atomic<size_t> counter(0);
+  TaskScheduler::TaskGroupContext context;
+  TaskScheduler::spawn([&]() {
+      for (size_t i=0; i<N; i++)
+        TaskScheduler::spawn([&counter,payload]() { counter += payload.data[127]; },&context);
+      TaskScheduler::wait();
+    },&context);
+  TaskScheduler::wait();
+
+  REQUIRE(context.cancellingException == nullptr);
+  REQUIRE(counter == 127*N);
+}
+
+#endif
+
+}
@@ -557,7 +557,9 @@ namespace embree
     MODE_INTERSECT1,
     MODE_INTERSECT4,
     MODE_INTERSECT8,
-    MODE_INTERSECT16
+    MODE_INTERSECT16,
+    MODE_INTERSECT1M,
+    MODE_INTERSECTNp
   };
 
   inline std::string to_string(IntersectMode imode)
@@ -568,6 +570,8 @@ namespace embree
     case MODE_INTERSECT4: return "4";
     case MODE_INTERSECT8: return "8";
     case MODE_INTERSECT16: return "16";
+    case MODE_INTERSECT1M: return "1M";
+    case MODE_INTERSECTNp: return "Np";
     default                : return "U";
     }
   }
@@ -580,6 +584,8 @@ namespace embree
     case MODE_INTERSECT4: return 16;
     case MODE_INTERSECT8: return 32;
     case MODE_INTERSECT16: return 64;
+    case MODE_INTERSECT1M: return 16;
+    case MODE_INTERSECTNp: return 16;
     default              : return 0;
     }
   }
@@ -623,6 +629,8 @@ namespace embree
     case MODE_INTERSECT4:
     case MODE_INTERSECT8:
     case MODE_INTERSECT16:
+    case MODE_INTERSECT1M:
+    case MODE_INTERSECTNp:
       switch (ivariant) {
       case VARIANT_INTERSECT: return true;
       case VARIANT_OCCLUDED : return true;
@@ -641,6 +649,8 @@ namespace embree
     case MODE_INTERSECT4:
     case MODE_INTERSECT8:
     case MODE_INTERSECT16:
+    case MODE_INTERSECT1M:
+    case MODE_INTERSECTNp:
       switch (ivariant) {
       case VARIANT_INTERSECT: return "Intersect" + to_string(imode);
       case VARIANT_OCCLUDED : return "Occluded" + to_string(imode);
@@ -781,6 +791,58 @@ namespace embree
       }
       break;
     }
+    case MODE_INTERSECT1M:
+    {
+      switch (ivariant & VARIANT_INTERSECT_OCCLUDED_MASK) {
+      case VARIANT_INTERSECT: rtcIntersect1M(scene,rays,N,sizeof(RTCRayHit),args); break;
+      case VARIANT_OCCLUDED : rtcOccluded1M (scene,(RTCRay*)rays,N,sizeof(RTCRayHit),(RTCOccludedArguments*)args); break;
+      default: assert(false);
+      }
+      break;
+    }
+    case MODE_INTERSECTNp:
+    {
+      std::vector<float> data(N*sizeof(RTCRayHit)/sizeof(float));
+      RTCRayHitN* rayhitN = (RTCRayHitN*) data.data();
+      RTCRayN* rayN = RTCRayHitN_RayN(rayhitN,N);
+      RTCHitN* hitN = RTCRayHitN_HitN(rayhitN,N);
+      for (unsigned int i=0; i<N; i++) setRay(rayhitN,N,i,rays[i]);
+
+      RTCRayHitNp rayhit;
+      rayhit.ray.org_x = &RTCRayN_org_x(rayN,N,0);
+      rayhit.ray.org_y = &RTCRayN_org_y(rayN,N,0);
+      rayhit.ray.org_z = &RTCRayN_org_z(rayN,N,0);
+      rayhit.ray.tnear = &RTCRayN_tnear(rayN,N,0);
+      rayhit.ray.dir_x = &RTCRayN_dir_x(rayN,N,0);
+      rayhit.ray.dir_y = &RTCRayN_dir_y(rayN,N,0);
+      rayhit.ray.dir_z = &RTCRayN_dir_z(rayN,N,0);
+      rayhit.ray.time  = &RTCRayN_time (rayN,N,0);
+      rayhit.ray.tfar  = &RTCRayN_tfar (rayN,N,0);
+      rayhit.ray.mask  = &RTCRayN_mask (rayN,N,0);
+      rayhit.ray.id    = &RTCRayN_id   (rayN,N,0);
+      rayhit.ray.flags = &RTCRayN_flags(rayN,N,0);
+      rayhit.hit.Ng_x   = &RTCHitN_Ng_x(hitN,N,0);
+      rayhit.hit.Ng_y   = &RTCHitN_Ng_y(hitN,N,0);
+      rayhit.hit.Ng_z   = &RTCHitN_Ng_z(hitN,N,0);
+      rayhit.hit.u      = &RTCHitN_u(hitN,N,0);
+      rayhit.hit.v      = &RTCHitN_v(hitN,N,0);
+      rayhit.hit.primID = &RTCHitN_primID(hitN,N,0);
+      rayhit.hit.geomID = &RTCHitN_geomID(hitN,N,0);
+      for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l) {
+        rayhit.hit.instID[l] = &RTCHitN_instID(hitN,N,0,l);
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        rayhit.hit.instPrimID[l] = &RTCHitN_instPrimID(hitN,N,0,l);
+#endif
+      }
+
+      switch (ivariant & VARIANT_INTERSECT_OCCLUDED_MASK) {
+      case VARIANT_INTERSECT: rtcIntersectNp(scene,&rayhit,N,args); break;
+      case VARIANT_OCCLUDED : rtcOccludedNp (scene,&rayhit.ray,N,(RTCOccludedArguments*)args); break;
+      default: assert(false);
+      }
+      for (unsigned int i=0; i<N; i++) rays[i] = getRay(rayhitN,N,i);
+      break;
+    }
     }
   }
 
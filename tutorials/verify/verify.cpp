@@ -782,6 +782,46 @@ namespace embree
     }
   };
 
+  struct NUMATest : public VerifyApplication::Test
+  {
+    NUMATest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* the detected topology has to be consistent */
+      const unsigned int numNodes = getNumberOfNUMANodes();
+      if (numNodes == 0 || getCurrentNUMANode() >= numNodes)
+        return VerifyApplication::FAILED;
+
+      /* NUMA aware allocation must not change the acceleration structure */
+      const size_t numRays = 1000;
+      std::vector<unsigned int> primIDs[2];
+      for (size_t numa=0; numa<2; numa++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ",numa="+std::to_string((long long)numa);
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,200));
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        RandomSampler sampler;
+        RandomSampler_init(sampler,0);
+        for (size_t i=0; i<numRays; i++)
+        {
+          RTCRayHit ray = fastMakeRay(zero,sampler);
+          rtcIntersect1(scene,&ray);
+          if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          primIDs[numa].push_back(ray.hit.primID);
+        }
+        AssertNoError(device);
+      }
+      return primIDs[0] == primIDs[1] ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct GetBoundsTest : public VerifyApplication::Test
   {
     GeometryType gtype;
@@ -1832,6 +1872,359 @@ namespace embree
     }
   };
 
+  struct AccelCacheTest : public VerifyApplication::Test
+  {
+    AccelCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* first pass builds without cache, second pass writes or loads the cache, third pass loads the cache */
+      std::vector<RTCRayHit> hits[3];
+      for (size_t pass=0; pass<3; pass++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+        if (pass > 0) cfg += ",accel_cache_dir=\".\"";
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        SceneFlags sflags = { RTC_SCENE_FLAG_NONE, RTC_BUILD_QUALITY_MEDIUM };
+        VerifyScene scene(device,sflags);
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,50));
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(Vec3fa(+1,0,0),1.0f,50));
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t i=0; i<256; i++)
+        {
+          const float x = -2.0f + 4.0f*float(i)/255.0f;
+          RTCRayHit ray = makeRay(Vec3fa(x,0.3f,-10),Vec3fa(0,0,1));
+          rtcIntersect1(scene,&ray);
+          hits[pass].push_back(ray);
+        }
+      }
+
+      for (size_t pass=1; pass<3; pass++)
+      {
+        for (size_t i=0; i<hits[0].size(); i++)
+        {
+          if (hits[pass][i].hit.geomID != hits[0][i].hit.geomID) return VerifyApplication::FAILED;
+          if (hits[pass][i].hit.primID != hits[0][i].hit.primID) return VerifyApplication::FAILED;
+          if (hits[pass][i].ray.tfar   != hits[0][i].ray.tfar  ) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct BVHOptimizeTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    int passes;
+
+    BVHOptimizeTest (std::string name, int isa, SceneFlags sflags, int passes)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), passes(passes) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* first pass builds without optimization, second pass optimizes the BVH */
+      std::vector<RTCRayHit> hits[2];
+      for (size_t pass=0; pass<2; pass++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+        cfg += ",bvh_optimize_passes=" + std::to_string(pass == 0 ? 0 : passes);
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        VerifyScene scene(device,sflags);
+        for (int i=0; i<4; i++) {
+          scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(float(2*i)-3.0f,0,0),1.0f,40));
+          scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(Vec3fa(float(2*i)-3.0f,1.5f,1.0f),0.8f,40));
+        }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t i=0; i<1024; i++)
+        {
+          const float x = -5.0f + 10.0f*float(i%32)/31.0f;
+          const float y = -2.0f + 5.0f*float(i/32)/31.0f;
+          RTCRayHit ray = makeRay(Vec3fa(x,y,-10),Vec3fa(0.01f*float(i%7),0.01f*float(i%5),1));
+          rtcIntersect1(scene,&ray);
+          hits[pass].push_back(ray);
+        }
+      }
+
+      for (size_t i=0; i<hits[0].size(); i++)
+      {
+        if (hits[1][i].hit.geomID != hits[0][i].hit.geomID) return VerifyApplication::FAILED;
+        if (hits[0][i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (abs(hits[1][i].ray.tfar-hits[0][i].ray.tfar) > 1E-4f) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct FineBinningTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    std::string config;
+
+    FineBinningTest (std::string name, int isa, SceneFlags sflags, std::string config)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), config(config) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* first pass builds with default binning, second pass bins coarse-to-fine */
+      std::vector<RTCRayHit> hits[2];
+      for (size_t pass=0; pass<2; pass++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+        cfg += pass == 0 ? std::string(",fine_binning_threshold=0") : config;
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        VerifyScene scene(device,sflags);
+        for (int i=0; i<4; i++) {
+          scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(float(2*i)-3.0f,0,0),1.0f,40));
+          scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(Vec3fa(float(2*i)-3.0f,1.5f,1.0f),0.8f,40));
+        }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        RTCSceneBuildStatistics stats;
+        rtcGetSceneBuildStatistics(scene,&stats);
+        AssertNoError(device);
+        size_t numFineBinningSplits = 0;
+        double fineBinningSAHSaved = 0.0;
+        for (size_t i=0; i<stats.numAccels; i++) {
+          if (stats.accels[i].fineBinningSAHSaved < 0.0 || stats.accels[i].fineBinningSAHSaved >= 1.0) return VerifyApplication::FAILED;
+          numFineBinningSplits += stats.accels[i].numFineBinningSplits;
+          fineBinningSAHSaved += stats.accels[i].fineBinningSAHSaved;
+        }
+        if (pass == 0 && (numFineBinningSplits != 0 || fineBinningSAHSaved != 0.0)) return VerifyApplication::FAILED;
+        if (pass == 1 && (numFineBinningSplits == 0 || fineBinningSAHSaved <= 0.0)) return VerifyApplication::FAILED;
+
+        for (size_t i=0; i<1024; i++)
+        {
+          const float x = -5.0f + 10.0f*float(i%32)/31.0f;
+          const float y = -2.0f + 5.0f*float(i/32)/31.0f;
+          RTCRayHit ray = makeRay(Vec3fa(x,y,-10),Vec3fa(0.01f*float(i%7),0.01f*float(i%5),1));
+          rtcIntersect1(scene,&ray);
+          hits[pass].push_back(ray);
+        }
+      }
+
+      for (size_t i=0; i<hits[0].size(); i++)
+      {
+        if (hits[1][i].hit.geomID != hits[0][i].hit.geomID) return VerifyApplication::FAILED;
+        if (hits[0][i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (abs(hits[1][i].ray.tfar-hits[0][i].ray.tfar) > 1E-4f) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct StreamingBuildTest : public VerifyApplication::Test
+  {
+    std::string config;
+
+    StreamingBuildTest (std::string name, int isa, std::string config)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), config(config) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* first pass builds the scene at once, second pass builds it within the memory budget */
+      std::vector<RTCRayHit> hits[2];
+      for (size_t pass=0; pass<2; pass++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+        if (pass > 0) cfg += config;
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        SceneFlags sflags = { RTC_SCENE_FLAG_NONE, RTC_BUILD_QUALITY_MEDIUM };
+        VerifyScene scene(device,sflags);
+        for (int i=0; i<4; i++) {
+          scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(float(2*i)-3.0f,0,0),1.0f,80));
+          scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(Vec3fa(float(2*i)-3.0f,1.5f,1.0f),0.8f,80));
+        }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t i=0; i<1024; i++)
+        {
+          const float x = -5.0f + 10.0f*float(i%32)/31.0f;
+          const float y = -2.0f + 5.0f*float(i/32)/31.0f;
+          RTCRayHit ray = makeRay(Vec3fa(x,y,-10),Vec3fa(0.01f*float(i%7),0.01f*float(i%5),1));
+          rtcIntersect1(scene,&ray);
+          hits[pass].push_back(ray);
+        }
+      }
+
+      for (size_t i=0; i<hits[0].size(); i++)
+      {
+        if (hits[1][i].hit.geomID != hits[0][i].hit.geomID) return VerifyApplication::FAILED;
+        if (hits[0][i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (abs(hits[1][i].ray.tfar-hits[0][i].ray.tfar) > 1E-4f) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct BuildStatisticsTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    BuildStatisticsTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      size_t numPrimitives = 0;
+      for (int i=0; i<4; i++) {
+        Ref<SceneGraph::Node> mesh = SceneGraph::createTriangleSphere(Vec3fa(float(2*i)-3.0f,0,0),1.0f,40);
+        numPrimitives += mesh.dynamicCast<SceneGraph::TriangleMeshNode>()->numPrimitives();
+        scene.addGeometry(sflags.qflags,mesh);
+      }
+
+      /* statistics are only available after committing the scene */
+      RTCSceneBuildStatistics stats;
+      rtcGetSceneBuildStatistics(scene,&stats);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      rtcGetSceneBuildStatistics(scene,&stats);
+      AssertNoError(device);
+
+      if (stats.numAccels != 1) return VerifyApplication::FAILED;
+      if (stats.numThreads == 0 || stats.time <= 0.0) return VerifyApplication::FAILED;
+
+      const RTCAccelBuildStatistics& accel = stats.accels[0];
+      if (std::string(accel.builder).empty()) return VerifyApplication::FAILED;
+      if (accel.numPrimitives != numPrimitives) return VerifyApplication::FAILED;
+      if (accel.time <= 0.0 || accel.time > stats.time) return VerifyApplication::FAILED;
+
+      /* every builder of triangle meshes generates primrefs and creates nodes and leaves */
+      const RTCBuildPhaseStatistics& primrefs = accel.phases[RTC_BUILD_PHASE_PRIMREF_GENERATION];
+      const RTCBuildPhaseStatistics& binning  = accel.phases[RTC_BUILD_PHASE_BINNING];
+      const RTCBuildPhaseStatistics& nodes    = accel.phases[RTC_BUILD_PHASE_NODE_ALLOCATION];
+      const RTCBuildPhaseStatistics& leaves   = accel.phases[RTC_BUILD_PHASE_LEAF_CREATION];
+      if (primrefs.bytesAllocated < numPrimitives*sizeof(RTCBounds)) return VerifyApplication::FAILED;
+      if (binning.time <= 0.0 || nodes.time != binning.time || leaves.time != binning.time) return VerifyApplication::FAILED;
+      if (nodes.bytesAllocated == 0 || leaves.bytesAllocated == 0) return VerifyApplication::FAILED;
+      if (nodes.bytesAllocated+leaves.bytesAllocated > accel.bytesAllocated) return VerifyApplication::FAILED;
+
+      for (size_t i=0; i<RTC_BUILD_PHASE_COUNT; i++) {
+        const RTCBuildPhaseStatistics& phase = accel.phases[i];
+        if (phase.time < 0.0 || phase.threadTime < 0.0 || phase.threadUtilization < 0.0) return VerifyApplication::FAILED;
+        if (phase.time == 0.0 && phase.threadUtilization != 0.0) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TraversalStatisticsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    TraversalStatisticsTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static void countingFilterN(const RTCFilterFunctionNArguments* const args) {
+      (*(std::atomic<size_t>*)args->geometryUserPtr)++;
+    }
+
+    static bool traceRays(VerifyScene& scene, IntersectMode imode, IntersectVariant ivariant, size_t numRays)
+    {
+      std::vector<RTCRayHit> rays(numRays);
+      for (size_t i=0; i<numRays; i++)
+        rays[i] = makeRay(Vec3fa(float(i%4),float((i/4)%4),0.0f),Vec3fa(0,0,-1));
+      IntersectWithMode(imode,ivariant,scene,rays.data(),(unsigned int)numRays);
+
+      bool passed = true;
+      for (size_t i=0; i<numRays; i++) {
+        if (ivariant & VARIANT_INTERSECT) passed &= rays[i].hit.geomID == 0;
+        else                              passed &= rays[i].ray.tfar == float(neg_inf);
+      }
+      return passed;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      const size_t numRays = 16;
+      const RTCQueryType types[2] = { RTC_QUERY_TYPE_INTERSECT, RTC_QUERY_TYPE_OCCLUDED };
+      const bool traced[2] = { (ivariant & VARIANT_INTERSECT) != 0, (ivariant & VARIANT_OCCLUDED) != 0 };
+      std::atomic<size_t> filterCalls(0);
+      RTCTraversalStatistics stats;
+
+      /* no statistics get gathered by default */
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_SAMPLING_RATE) != 0)
+          return VerifyApplication::FAILED;
+
+        VerifyScene scene(device,sflags);
+        scene.addPlane(sampler,RTC_BUILD_QUALITY_MEDIUM,4,Vec3fa(-0.75f,-0.25f,-10.0f),Vec3fa(4,0,0),Vec3fa(0,4,0));
+        rtcCommitScene (scene);
+        AssertNoError(device);
+        if (!traceRays(scene,imode,ivariant,numRays)) return VerifyApplication::FAILED;
+        for (auto type : types) {
+          rtcGetDeviceTraversalStatistics(device,type,&stats);
+          AssertNoError(device);
+          if (stats.numRays != 0 || stats.numNodes != 0) return VerifyApplication::FAILED;
+        }
+      }
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",traversal_statistics=1";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_SAMPLING_RATE) != 1)
+        return VerifyApplication::FAILED;
+
+      VerifyScene scene(device,sflags);
+      unsigned int geomID = scene.addPlane(sampler,RTC_BUILD_QUALITY_MEDIUM,4,Vec3fa(-0.75f,-0.25f,-10.0f),Vec3fa(4,0,0),Vec3fa(0,4,0)).first;
+      const bool filters = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED);
+      if (filters) {
+        RTCGeometry geom = rtcGetGeometry(scene,geomID);
+        rtcSetGeometryUserData(geom,&filterCalls);
+        rtcSetGeometryIntersectFilterFunction(geom,countingFilterN);
+        rtcSetGeometryOccludedFilterFunction(geom,countingFilterN);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      if (!traceRays(scene,imode,ivariant,numRays)) return VerifyApplication::FAILED;
+
+      /* intersect and occluded queries are counted separately */
+      size_t numFilterCalls = 0;
+      for (size_t i=0; i<2; i++)
+      {
+        rtcGetDeviceTraversalStatistics(device,types[i],&stats);
+        AssertNoError(device);
+        numFilterCalls += stats.numFilterCalls;
+        if (!traced[i]) {
+          if (stats.numRays != 0 || stats.numNodes != 0 || stats.numFilterCalls != 0) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (stats.numRays != numRays || stats.numSampledRays != numRays) return VerifyApplication::FAILED;
+        if (stats.numNodes == 0 || stats.numLeaves == 0 || stats.numPrimitives < stats.numLeaves) return VerifyApplication::FAILED;
+        if (filters && stats.numFilterCalls == 0) return VerifyApplication::FAILED;
+      }
+      if (numFilterCalls != filterCalls) return VerifyApplication::FAILED;
+
+      rtcResetDeviceTraversalStatistics(device);
+      for (auto type : types) {
+        rtcGetDeviceTraversalStatistics(device,type,&stats);
+        AssertNoError(device);
+        if (stats.numRays != 0 || stats.numSampledRays != 0 || stats.numNodes != 0 || stats.numLeaves != 0 || stats.numPrimitives != 0 || stats.numFilterCalls != 0)
+          return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct UpdateTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -1912,6 +2305,363 @@ namespace embree
     }
   };
 
+  struct UpdateRangeTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    
+    UpdateRangeTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* grid of disconnected triangles and quads, each with its own vertices */
+      VerifyScene scene(device,sflags);
+      const size_t numPrims = 8192;
+      const size_t gridWidth = 128;
+      std::vector<float> height[2];
+      RTCGeometry hgeom[2];
+      for (size_t g=0; g<2; g++)
+      {
+        const size_t numPrimVertices = g == 0 ? 3 : 4;
+        hgeom[g] = rtcNewGeometry(device, g == 0 ? RTC_GEOMETRY_TYPE_TRIANGLE : RTC_GEOMETRY_TYPE_QUAD);
+        rtcSetGeometryBuildQuality(hgeom[g],RTC_BUILD_QUALITY_REFIT);
+        Vec3fa* vertices = (Vec3fa*) rtcSetNewGeometryBuffer(hgeom[g],RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,sizeof(Vec3fa),numPrimVertices*numPrims);
+        unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(hgeom[g],RTC_BUFFER_TYPE_INDEX,0,
+                                                                         g == 0 ? RTC_FORMAT_UINT3 : RTC_FORMAT_UINT4,numPrimVertices*sizeof(unsigned int),numPrims);
+        for (size_t i=0; i<numPrims; i++)
+        {
+          const float x = float(i%gridWidth) + 200.0f*float(g), z = float(i/gridWidth);
+          vertices[numPrimVertices*i+0] = Vec3fa(x+0.0f,0.0f,z+0.0f);
+          vertices[numPrimVertices*i+1] = Vec3fa(x+0.8f,0.0f,z+0.0f);
+          if (g == 0) vertices[numPrimVertices*i+2] = Vec3fa(x+0.0f,0.0f,z+0.8f);
+          else {
+            vertices[numPrimVertices*i+2] = Vec3fa(x+0.8f,0.0f,z+0.8f);
+            vertices[numPrimVertices*i+3] = Vec3fa(x+0.0f,0.0f,z+0.8f);
+          }
+          for (size_t j=0; j<numPrimVertices; j++)
+            indices[numPrimVertices*i+j] = (unsigned int)(numPrimVertices*i+j);
+        }
+        rtcCommitGeometry(hgeom[g]);
+        rtcAttachGeometryByID(scene,hgeom[g],(unsigned int)g);
+        rtcReleaseGeometry(hgeom[g]);
+        height[g].resize(numPrims,0.0f);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t iter=0; iter<8; iter++)
+      {
+        for (size_t g=0; g<2; g++)
+        {
+          /* lift two ranges of primitives, the third iteration takes the parallel path */
+          const size_t numPrimVertices = g == 0 ? 3 : 4;
+          Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(hgeom[g],RTC_BUFFER_TYPE_VERTEX,0);
+          const size_t ranges[2][2] = {
+            { (997*iter+13*g) % numPrims, iter == 3 ? 6000 : 17*iter+1 },
+            { (3001*iter+5) % numPrims, 3 }
+          };
+          for (size_t r=0; r<2; r++)
+          {
+            const size_t begin = ranges[r][0];
+            const size_t end = min(begin+ranges[r][1],numPrims);
+            for (size_t i=begin; i<end; i++) {
+              height[g][i] += 1.0f;
+              for (size_t j=0; j<numPrimVertices; j++)
+                vertices[numPrimVertices*i+j].y = height[g][i];
+            }
+            rtcUpdateGeometryBufferRange(hgeom[g],RTC_BUFFER_TYPE_VERTEX,0,numPrimVertices*begin,numPrimVertices*(end-begin));
+          }
+          rtcCommitGeometry(hgeom[g]);
+        }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t g=0; g<2; g++)
+        {
+          for (size_t i=0; i<numPrims; i++)
+          {
+            const float x = float(i%gridWidth) + 200.0f*float(g), z = float(i/gridWidth);
+            RTCRayHit ray = makeRay(Vec3fa(x+0.2f,100.0f,z+0.2f),Vec3fa(0,-1,0));
+            rtcIntersect1(scene,&ray);
+            if (ray.hit.geomID != g || ray.hit.primID != i) return VerifyApplication::FAILED;
+            if (abs(ray.ray.tfar-(100.0f-height[g][i])) > 1E-3f) return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct UpdateRangeSubdivTest : public VerifyApplication::Test
+  {
+    RTCSubdivisionMode mode;
+    
+    UpdateRangeSubdivTest (std::string name, int isa, RTCSubdivisionMode mode)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), mode(mode) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* grid of quads with two copies of each vertex, geometry 0 gets
+       * index range updates, geometry 1 full index buffer updates */
+      const unsigned int W = 32, numVertices = (W+1)*(W+1), numFaces = W*W;
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      RTCScene scene[2] = { scene0, scene1 };
+      RTCGeometry geom[2];
+      unsigned int* indices[2];
+      for (size_t g=0; g<2; g++)
+      {
+        geom[g] = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_SUBDIVISION);
+        Vec3fa* vertices = (Vec3fa*) rtcSetNewGeometryBuffer(geom[g],RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,sizeof(Vec3fa),2*numVertices);
+        for (unsigned int i=0; i<2*numVertices; i++) {
+          const unsigned int x = (i%numVertices)%(W+1), z = (i%numVertices)/(W+1);
+          vertices[i] = Vec3fa(float(x),0.2f*float((3*x+7*z)%5),float(z));
+        }
+        unsigned int* faces = (unsigned int*) rtcSetNewGeometryBuffer(geom[g],RTC_BUFFER_TYPE_FACE,0,RTC_FORMAT_UINT,sizeof(unsigned int),numFaces);
+        for (unsigned int f=0; f<numFaces; f++) faces[f] = 4;
+        indices[g] = (unsigned int*) rtcSetNewGeometryBuffer(geom[g],RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT,sizeof(unsigned int),4*numFaces);
+        unsigned int* creases = (unsigned int*) rtcSetNewGeometryBuffer(geom[g],RTC_BUFFER_TYPE_VERTEX_CREASE_INDEX,0,RTC_FORMAT_UINT,sizeof(unsigned int),1);
+        float* weights = (float*) rtcSetNewGeometryBuffer(geom[g],RTC_BUFFER_TYPE_VERTEX_CREASE_WEIGHT,0,RTC_FORMAT_FLOAT,sizeof(float),1);
+        creases[0] = numVertices/2; weights[0] = 2.0f;
+        rtcSetGeometrySubdivisionMode(geom[g],0,mode);
+      }
+
+      /* faces switch between regular, flipped, disconnected, and duplicated layouts */
+      auto setFace = [&] (unsigned int f, unsigned int layout)
+      {
+        const unsigned int x = f%W, z = f/W, v = z*(W+1)+x;
+        const unsigned int g = (f+1)%numFaces, u = (g/W)*(W+1)+g%W;
+        const unsigned int layouts[4][4] = {
+          { v, v+1, v+W+2, v+W+1 },
+          { v, v+W+1, v+W+2, v+1 },
+          { v+numVertices, v+1, v+W+2, v+W+1+numVertices },
+          { u, u+1, u+W+2, u+W+1 }
+        };
+        for (size_t g=0; g<2; g++)
+          for (size_t i=0; i<4; i++)
+            indices[g][4*f+i] = layouts[layout][i];
+      };
+      for (unsigned int f=0; f<numFaces; f++) setFace(f,0);
+      
+      for (size_t g=0; g<2; g++) {
+        rtcCommitGeometry(geom[g]);
+        rtcAttachGeometry(scene[g],geom[g]);
+        rtcReleaseGeometry(geom[g]);
+      }
+      AssertNoError(device);
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler,int(mode));
+      for (size_t iter=0; iter<16; iter++)
+      {
+        /* modify two nearby ranges of faces, the last iteration modifies most of the mesh */
+        const unsigned int base = RandomSampler_getInt(sampler)%numFaces;
+        for (size_t r=0; r<2; r++)
+        {
+          const unsigned int begin = (base+r*(RandomSampler_getInt(sampler)%32))%numFaces;
+          const unsigned int end = min(begin + (iter == 15 ? numFaces : 1+RandomSampler_getInt(sampler)%8),numFaces);
+          for (unsigned int f=begin; f<end; f++)
+            setFace(f,RandomSampler_getInt(sampler)%4);
+          rtcUpdateGeometryBufferRange(geom[0],RTC_BUFFER_TYPE_INDEX,0,4*begin,4*(end-begin));
+        }
+        rtcUpdateGeometryBuffer(geom[1],RTC_BUFFER_TYPE_INDEX,0);
+        for (size_t g=0; g<2; g++) {
+          rtcCommitGeometry(geom[g]);
+          rtcCommitScene(scene[g]);
+        }
+        AssertNoError(device);
+
+        /* both geometries have to end up with the same half edge structure */
+        for (unsigned int e=0; e<4*numFaces; e++)
+          if (rtcGetGeometryOppositeHalfEdge(geom[0],0,e) != rtcGetGeometryOppositeHalfEdge(geom[1],0,e))
+            return VerifyApplication::FAILED;
+
+        /* and the same surface, duplicated faces may report different primitive IDs */
+        for (unsigned int z=0; z<W; z++)
+        {
+          for (unsigned int x=0; x<W; x++)
+          {
+            RTCRayHit ray[2];
+            for (size_t g=0; g<2; g++) {
+              ray[g] = makeRay(Vec3fa(float(x)+0.3f,10.0f,float(z)+0.6f),Vec3fa(0,-1,0));
+              rtcIntersect1(scene[g],&ray[g]);
+            }
+            if (ray[0].hit.geomID != ray[1].hit.geomID) return VerifyApplication::FAILED;
+            if (abs(ray[0].ray.tfar-ray[1].ray.tfar) > 1E-4f) return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct IncrementalBuildTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool incremental;
+    
+    IncrementalBuildTest (std::string name, int isa, SceneFlags sflags, bool incremental)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), incremental(incremental) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      if (incremental) cfg += ",incremental_build=1";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* many small objects such that single object updates take the incremental path */
+      VerifyScene scene(device,sflags);
+      const size_t numObjects = 48;
+      const size_t numPhi = 5;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      std::vector<Vec3fa> pos(numObjects);
+      for (size_t i=0; i<numObjects; i++) {
+        pos[i] = Vec3fa(3.0f*float(i%24),0.0f,i < 24 ? 0.0f : 3.0f);
+        if (i < 24) scene.addSphere    (sampler,RTC_BUILD_QUALITY_MEDIUM,pos[i],1.0f,numPhi);
+        else        scene.addQuadSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,pos[i],1.0f,numPhi);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t iter=0; iter<12; iter++)
+      {
+        /* move a different object each iteration far away */
+        const size_t objectID = (5*iter) % numObjects;
+        const Vec3fa oldPos = pos[objectID];
+        Vec3fa ds(0.5f,0.0f,20.0f);
+        UpdateTest::move_mesh(rtcGetGeometry(scene,(unsigned)objectID),numVertices,ds);
+        pos[objectID] += ds;
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t i=0; i<numObjects; i++) {
+          RTCRayHit ray = makeRay(pos[i]+Vec3fa(0.1f,10,0.1f),Vec3fa(0,-1,0));
+          rtcIntersect1(scene,&ray);
+          if (ray.hit.geomID != i) return VerifyApplication::FAILED;
+        }
+        
+        RTCRayHit ray = makeRay(oldPos+Vec3fa(0.1f,10,0.1f),Vec3fa(0,-1,0));
+        rtcIntersect1(scene,&ray);
+        if (ray.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CommitScenesTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    
+    CommitScenesTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static unsigned int addInstance(RTCDevice device, RTCScene scene, RTCScene object, const AffineSpace3fa& xfm)
+    {
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom,object);
+      rtcSetGeometryTransform(geom,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+      rtcCommitGeometry(geom);
+      unsigned int geomID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      return geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* many small leaf scenes instanced by one top-level scene and by one instance array */
+      const size_t numLeaves = 16;
+      std::vector<Ref<VerifyScene>> leaves(numLeaves);
+      for (size_t i=0; i<numLeaves; i++) {
+        leaves[i] = new VerifyScene(device,sflags);
+        leaves[i]->addSphere(sampler,sflags.qflags,Vec3fa(3.0f*float(i),0.0f,0.0f),1.0f,10+i);
+      }
+      VerifyScene top(device,sflags);
+      for (size_t i=0; i<numLeaves; i++)
+        addInstance(device,top,*leaves[i],one);
+
+      VerifyScene arrayTop(device,sflags);
+      std::vector<AffineSpace3fa> transforms;
+      for (size_t i=0; i<4; i++)
+        transforms.push_back(AffineSpace3fa::translate(Vec3fa(0.0f,0.0f,3.0f*float(i+1))));
+      RTCGeometry array = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE_ARRAY);
+      rtcSetSharedGeometryBuffer(array, RTC_BUFFER_TYPE_TRANSFORM, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, (void*)transforms.data(), 0, sizeof(AffineSpace3fa), transforms.size());
+      rtcSetGeometryInstancedScene(array,*leaves[0]);
+      rtcCommitGeometry(array);
+      rtcAttachGeometry(arrayTop,array);
+      rtcReleaseGeometry(array);
+      AssertNoError(device);
+
+      /* instancing scenes come first, a leaf scene is passed twice */
+      std::vector<RTCScene> scenes;
+      std::vector<int> priorities;
+      scenes.push_back(top);      priorities.push_back(0);
+      scenes.push_back(arrayTop); priorities.push_back(1);
+      for (size_t i=0; i<numLeaves; i++) {
+        scenes.push_back(*leaves[i]); priorities.push_back(int(i%3));
+      }
+      scenes.push_back(*leaves[0]); priorities.push_back(5);
+      rtcCommitScenes(scenes.data(),priorities.data(),(unsigned int)scenes.size());
+      AssertNoError(device);
+
+      for (size_t i=0; i<numLeaves; i++) {
+        RTCRayHit ray = makeRay(Vec3fa(3.0f*float(i)+0.1f,10.0f,0.1f),Vec3fa(0,-1,0));
+        rtcIntersect1(top,&ray);
+        if (ray.hit.geomID != 0 || ray.hit.instID[0] != i) return VerifyApplication::FAILED;
+      }
+      for (size_t i=0; i<transforms.size(); i++) {
+        RTCRayHit ray = makeRay(Vec3fa(0.1f,10.0f,3.0f*float(i+1)+0.1f),Vec3fa(0,-1,0));
+        rtcIntersect1(arrayTop,&ray);
+        if (ray.hit.geomID != 0 || ray.hit.instID[0] != 0 || ray.hit.instPrimID[0] != i) return VerifyApplication::FAILED;
+      }
+
+      /* instances of modified leaves get committed as usual, no priorities are specified */
+      for (size_t i=0; i<numLeaves; i+=2) {
+        leaves[i]->addSphere(sampler,sflags.qflags,Vec3fa(3.0f*float(i),0.0f,-5.0f),1.0f,10);
+        rtcCommitGeometry(rtcGetGeometry(top,(unsigned int)i));
+      }
+      rtcCommitGeometry(rtcGetGeometry(arrayTop,0));
+      rtcCommitScenes(scenes.data(),nullptr,(unsigned int)scenes.size());
+      AssertNoError(device);
+      for (size_t i=0; i<numLeaves; i++) {
+        RTCRayHit ray = makeRay(Vec3fa(3.0f*float(i)+0.1f,10.0f,-4.9f),Vec3fa(0,-1,0));
+        rtcIntersect1(top,&ray);
+        if ((ray.hit.geomID != RTC_INVALID_GEOMETRY_ID) != (i%2 == 0)) return VerifyApplication::FAILED;
+      }
+
+      /* scenes instancing each other cyclically cannot get committed */
+      VerifyScene cycle0(device,sflags), cycle1(device,sflags);
+      addInstance(device,cycle0,cycle1,one);
+      addInstance(device,cycle1,cycle0,one);
+      RTCScene cycle[2] = { cycle0, cycle1 };
+      rtcCommitScenes(cycle,nullptr,2);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      rtcCommitScenes(nullptr,nullptr,0);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct GarbageGeometryTest : public VerifyApplication::Test
   {
     GarbageGeometryTest (std::string name, int isa)
@@ -2178,6 +2928,156 @@ namespace embree
     }
   };
 
+  struct TessellationCacheTest : public VerifyApplication::Test
+  {
+    RTCTessellationCacheMode mode;
+    static const unsigned int W = 128; // faces per row of the grid
+    
+    TessellationCacheTest (std::string name, int isa, RTCTessellationCacheMode mode)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), mode(mode) {}
+
+    struct InterpolateThread
+    {
+      RTCGeometry geom;
+      const std::vector<Vec3f>* reference;
+      unsigned int seed;
+      std::atomic<size_t>* numFailed;
+    };
+
+    static Vec3f interpolate(RTCGeometry geom, unsigned int primID) 
+    {
+      Vec3f P;
+      rtcInterpolate0(geom,primID,0.25f,0.75f,RTC_BUFFER_TYPE_VERTEX,0,&P.x,3);
+      return P;
+    }
+
+    static void interpolateThread(InterpolateThread* task)
+    {
+      for (unsigned int i=0; i<10000; i++) {
+        const unsigned int primID = (task->seed+i*7919)%(W*W);
+        if (interpolate(task->geom,primID) != (*task->reference)[primID])
+          (*task->numFailed)++;
+      }
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* subdivision grid of W*W quads */
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SUBDIVISION);
+      Vec3f* vertices = (Vec3f*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,sizeof(Vec3f),(W+1)*(W+1));
+      unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT,sizeof(unsigned int),4*W*W);
+      unsigned int* faces = (unsigned int*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_FACE,0,RTC_FORMAT_UINT,sizeof(unsigned int),W*W);
+      for (unsigned int y=0; y<=W; y++)
+        for (unsigned int x=0; x<=W; x++)
+          vertices[y*(W+1)+x] = Vec3f(float(x),float(y),random_float());
+      for (unsigned int y=0; y<W; y++) {
+        for (unsigned int x=0; x<W; x++) {
+          const unsigned int f = y*W+x;
+          faces[f] = 4;
+          indices[4*f+0] = (y+0)*(W+1)+(x+0);
+          indices[4*f+1] = (y+0)*(W+1)+(x+1);
+          indices[4*f+2] = (y+1)*(W+1)+(x+1);
+          indices[4*f+3] = (y+1)*(W+1)+(x+0);
+        }
+      }
+      rtcCommitGeometry(geom);
+      AssertNoError(device);
+
+      /* reference results with the default cache */
+      std::vector<Vec3f> reference(W*W);
+      for (unsigned int i=0; i<W*W; i++)
+        reference[i] = interpolate(geom,i);
+      
+      /* the cache size is the maximum requested by all devices */
+      const ssize_t defaultSize = rtcGetDeviceProperty(state->device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE);
+      auto setCacheSize = [&] (size_t bytes) {
+        rtcSetDeviceProperty(state->device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE,bytes);
+        rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE,bytes);
+      };
+
+      /* a budget of about a tenth of all patches */
+      const size_t budget = 512*1024;
+      setCacheSize(budget);
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MODE,mode);
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS,0);
+      AssertNoError(device);
+      bool passed = true;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MODE) == mode;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE) == (ssize_t) budget;
+      printf("DBG size %zd mode %zd\n",rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE),rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MODE));
+
+      /* the first pass constructs all patches, the second hits patches that fit into the cache */
+      for (unsigned int i=0; i<W*W; i++)
+        passed &= interpolate(geom,i) == reference[i];
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES) == W*W;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS) == 0;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS) > 0;
+      for (unsigned int i=W*W-64; i<W*W; i++)
+        passed &= interpolate(geom,i) == reference[i];
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS) == 64;
+      printf("DBG passed %d misses %zd hits %zd ev %zd\n",passed,rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES),rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS),rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS));
+      
+      /* a hot set of patches that is accessed between streaming through all other patches */
+      const unsigned int numHot = 64, numCold = 256;
+      size_t hotMisses = 0;
+      for (unsigned int round=0; round<(W*W-numHot)/numCold; round++)
+      {
+        const ssize_t misses = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES);
+        for (unsigned int i=0; i<numHot; i++)
+          passed &= interpolate(geom,i) == reference[i];
+        if (round > 0) hotMisses += rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES)-misses;
+        
+        for (unsigned int i=0; i<numCold; i++) {
+          const unsigned int primID = numHot+round*numCold+i;
+          passed &= interpolate(geom,primID) == reference[primID];
+        }
+      }
+      
+      /* least recently used eviction keeps the hot patches */
+      printf("DBG passed %d hotMisses %zu\n",passed,hotMisses);
+      if (mode == RTC_TESSELLATION_CACHE_MODE_LRU)
+        passed &= hotMisses == 0;
+      
+      /* concurrent lookups with a budget that holds only a few patches */
+      setCacheSize(16*1024);
+      AssertNoError(device);
+      std::atomic<size_t> numFailed(0);
+      const size_t numThreads = min(size_t(8),size_t(getNumberOfLogicalThreads()));
+      std::vector<InterpolateThread> tasks(numThreads);
+      std::vector<thread_t> threads;
+      for (size_t i=0; i<numThreads; i++) {
+        tasks[i].geom = geom;
+        tasks[i].reference = &reference;
+        tasks[i].seed = random_int();
+        tasks[i].numFailed = &numFailed;
+        threads.push_back(createThread((thread_func)interpolateThread,&tasks[i]));
+      }
+      for (size_t i=0; i<threads.size(); i++)
+        join(threads[i]);
+      passed &= numFailed == 0;
+      printf("DBG passed %d failed %zu\n",passed,numFailed.load());
+
+      /* modifying the mesh invalidates all cached patches */
+      for (unsigned int i=0; i<(W+1)*(W+1); i++)
+        vertices[i].x += 1.0f;
+      rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(geom);
+      for (unsigned int i=0; i<W*W; i++)
+        passed &= abs(interpolate(geom,i).x-reference[i].x-1.0f) < 1E-4f;
+      
+      rtcReleaseGeometry(geom);
+      setCacheSize(defaultSize);
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MODE,RTC_TESSELLATION_CACHE_MODE_SEGMENTED);
+      AssertNoError(device);
+      
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct InterpolateTrianglesTest : public VerifyApplication::Test
   {
     size_t N;
@@ -5317,6 +6217,8 @@ namespace embree
       intersectModes.push_back(MODE_INTERSECT4);
       intersectModes.push_back(MODE_INTERSECT8);
       intersectModes.push_back(MODE_INTERSECT16);
+      intersectModes.push_back(MODE_INTERSECT1M);
+      intersectModes.push_back(MODE_INTERSECTNp);
 
       size_t errorCounter = 0;
       unsigned int sceneIndex = 0;
@@ -5381,12 +6283,14 @@ namespace embree
     float intensity;
     std::vector<IntersectMode> intersectModes;
     
-    MemoryMonitorTest (std::string name, int isa, thread_func func, float intensity)
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), func(func), intensity(intensity) {}
+    std::string config;
+    
+    MemoryMonitorTest (std::string name, int isa, thread_func func, float intensity, std::string config = "")
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), func(func), intensity(intensity), config(config) {}
     
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+config;
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
       
@@ -5395,6 +6299,8 @@ namespace embree
       intersectModes.push_back(MODE_INTERSECT4);
       intersectModes.push_back(MODE_INTERSECT8);
       intersectModes.push_back(MODE_INTERSECT16);
+      intersectModes.push_back(MODE_INTERSECT1M);
+      intersectModes.push_back(MODE_INTERSECTNp);
       
       rtcSetDeviceMemoryMonitorFunction(device,monitorMemoryFunction,nullptr);
       
@@ -5724,7 +6630,94 @@ namespace embree
       return 1.0f/float(t1-t0);
     }
   };
-  
+
+  /* measures the spawn and steal overhead of the tasking system using
+   * tasks that do no work, compare builds with different tasking systems
+   * to compare their overhead */
+  struct TaskingBenchmark : public VerifyApplication::Benchmark
+  {
+    size_t numOuterTasks;
+    size_t numInnerTasks;
+    std::vector<char> touched;
+    RTCDeviceRef device;
+
+    TaskingBenchmark (std::string name, int isa, size_t numOuterTasks, size_t numInnerTasks)
+      : VerifyApplication::Benchmark(name,isa,"Mtasks/s",true,10), numOuterTasks(numOuterTasks), numInnerTasks(numInnerTasks) {}
+
+    bool setup(VerifyApplication* state)
+    {
+      /* the device creates the tasking system */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      touched.resize(numOuterTasks*numInnerTasks);
+      return true;
+    }
+
+    float benchmark(VerifyApplication* state)
+    {
+      double t0 = getSeconds();
+      parallel_for(size_t(0),numOuterTasks,size_t(1),[&](const range<size_t>& r0) {
+          for (size_t i=r0.begin(); i<r0.end(); i++) {
+            if (numInnerTasks == 1) { touched[i] = 1; continue; }
+            parallel_for(size_t(0),numInnerTasks,size_t(1),[&](const range<size_t>& r1) {
+                for (size_t j=r1.begin(); j<r1.end(); j++)
+                  touched[i*numInnerTasks+j] = 1;
+              });
+          }
+        });
+      double t1 = getSeconds();
+      return 1E-6f * float(numOuterTasks*numInnerTasks)/float(t1-t0);
+    }
+
+    virtual void cleanup(VerifyApplication* state)
+    {
+      touched.clear();
+      device = nullptr;
+    }
+  };
+
+  /* measures the per core throughput of the binning phase of the SAH
+   * builder as primitives per second of binning time of a single
+   * threaded build, compare the ISAs to compare the binning kernels */
+  struct BinningBenchmark : public VerifyApplication::Benchmark
+  {
+    size_t numPhi;
+    RTCDeviceRef device;
+    Ref<VerifyScene> scene;
+
+    BinningBenchmark (std::string name, int isa, size_t numPhi)
+      : VerifyApplication::Benchmark(name,isa,"Mprims/s",true,10), numPhi(numPhi) {}
+
+    bool setup(VerifyApplication* state)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ",threads=1";
+      device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      scene = new VerifyScene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene->addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,numPhi));
+      return true;
+    }
+
+    float benchmark(VerifyApplication* state)
+    {
+      rtcCommitGeometry(rtcGetGeometry(*scene,0));
+      rtcCommitScene(*scene);
+      AssertNoError(device);
+
+      RTCSceneBuildStatistics stats;
+      rtcGetSceneBuildStatistics(*scene,&stats);
+      const RTCAccelBuildStatistics& accel = stats.accels[0];
+      return 1E-6f*float(accel.numPrimitives)/float(accel.phases[RTC_BUILD_PHASE_BINNING].threadTime);
+    }
+
+    virtual void cleanup(VerifyApplication* state)
+    {
+      scene = nullptr;
+      device = nullptr;
+    }
+  };
+
   struct ParallelIntersectBenchmark : public VerifyApplication::Benchmark
   {
     unsigned int N, dN;
@@ -5903,6 +6896,18 @@ namespace embree
         }
         break;
       }
+      case MODE_INTERSECT1M: 
+      {
+        vector_t<RTCRayHit,aligned_allocator<RTCRayHit,16>> rays;
+        for (size_t y=y0; y<y1; y++)
+          for (size_t x=x0; x<x1; x++)
+            rays.push_back(fastMakeRay(zero,Vec3f(float(x)*rcpWidth,1,float(y)*rcpHeight)));
+        switch (ivariant & VARIANT_INTERSECT_OCCLUDED_MASK) {
+        case VARIANT_INTERSECT: rtcIntersect1M(*scene,rays.data(),(unsigned int)rays.size(),sizeof(RTCRayHit),&args); break;
+        case VARIANT_OCCLUDED : rtcOccluded1M (*scene,(RTCRay*)rays.data(),(unsigned int)rays.size(),sizeof(RTCRayHit),(RTCOccludedArguments*)&args); break;
+        }
+        break;
+      }
       default: break;
       }
     }
@@ -6046,6 +7051,17 @@ namespace embree
         }
         break;
       }
+      case MODE_INTERSECT1M: 
+      {
+        vector_t<RTCRayHit,aligned_allocator<RTCRayHit,16>> rays(dn);
+        for (size_t j=0; j<dn; j++)
+          fastMakeRay(rays[j],zero,sampler);
+        switch (ivariant & VARIANT_INTERSECT_OCCLUDED_MASK) {
+        case VARIANT_INTERSECT: rtcIntersect1M(*scene,rays.data(),(unsigned int)dn,sizeof(RTCRayHit),&args); break;
+        case VARIANT_OCCLUDED : rtcOccluded1M (*scene,(RTCRay*)rays.data(),(unsigned int)dn,sizeof(RTCRayHit),(RTCOccludedArguments*)&args); break;
+        }
+        break;
+      }
       default: break;
       }
     }
@@ -6255,6 +7271,8 @@ namespace embree
     intersectModes.push_back(MODE_INTERSECT4);
     intersectModes.push_back(MODE_INTERSECT8);
     intersectModes.push_back(MODE_INTERSECT16);
+    intersectModes.push_back(MODE_INTERSECT1M);
+    intersectModes.push_back(MODE_INTERSECTNp);
         
     /* create a list of all intersect variants for each intersect mode */
     intersectVariants.push_back(VARIANT_INTERSECT_COHERENT);
@@ -6312,6 +7330,7 @@ namespace embree
       push(new TestGroup(stringOfISA(isa),false,false));
       
       groups.top()->add(new MultipleDevicesTest("multiple_devices",isa));
+      groups.top()->add(new NUMATest("numa",isa));
       groups.top()->add(new TypesTest("types_test",isa));
 
       push(new TestGroup("get_bounds",true,true));
@@ -6384,6 +7403,52 @@ namespace embree
       groups.top()->add(new TriangleSplitRegression(isa));
       groups.pop();
 
+      groups.top()->add(new AccelCacheTest("accel_cache",isa));
+
+      push(new TestGroup("bvh_optimize",true,true));
+      groups.top()->add(new BVHOptimizeTest("static.high",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH),2));
+      groups.top()->add(new BVHOptimizeTest("static.medium",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),4));
+      groups.top()->add(new BVHOptimizeTest("robust.medium",isa,SceneFlags(RTC_SCENE_FLAG_ROBUST,RTC_BUILD_QUALITY_MEDIUM),4));
+      groups.top()->add(new BVHOptimizeTest("dynamic.medium",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_MEDIUM),4));
+      groups.pop();
+
+      push(new TestGroup("fine_binning",true,true));
+      groups.top()->add(new FineBinningTest("static.high",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH),""));
+      groups.top()->add(new FineBinningTest("static.medium",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),",fine_binning_threshold=1024"));
+      groups.top()->add(new FineBinningTest("dynamic.medium",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_MEDIUM),",fine_binning_threshold=1024"));
+      groups.pop();
+
+      push(new TestGroup("streaming_build",true,true));
+      groups.top()->add(new StreamingBuildTest("budget",isa,",build_memory_budget=1"));
+      groups.top()->add(new StreamingBuildTest("budget.file_arena",isa,",build_memory_budget=1,alloc_arena_dir=\".\""));
+      groups.pop();
+
+      push(new TestGroup("build_statistics",true,true));
+      groups.top()->add(new BuildStatisticsTest("static.medium",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
+      groups.top()->add(new BuildStatisticsTest("static.high",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH)));
+      groups.top()->add(new BuildStatisticsTest("dynamic.medium",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_MEDIUM)));
+      groups.pop();
+
+      push(new TestGroup("traversal_statistics",true,true));
+      for (auto imode : intersectModes)
+        for (auto ivariant : intersectVariants)
+          if (has_variant(imode,ivariant))
+            groups.top()->add(new TraversalStatisticsTest(to_string(imode,ivariant),isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("incremental_build",true,true));
+      for (auto sflags : sceneFlagsDynamic)
+        groups.top()->add(new IncrementalBuildTest(to_string(sflags),isa,sflags,false));
+      groups.top()->add(new IncrementalBuildTest("static.incremental",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),true));
+      groups.top()->add(new IncrementalBuildTest("dynamic.incremental",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_MEDIUM),true));
+      groups.top()->add(new IncrementalBuildTest("robust.incremental",isa,SceneFlags(RTC_SCENE_FLAG_ROBUST,RTC_BUILD_QUALITY_MEDIUM),true));
+      groups.pop();
+
+      push(new TestGroup("commit_scenes",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new CommitScenesTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
       push(new TestGroup("update",true,true));
       for (auto sflags : sceneFlagsDynamic) {
         for (auto imode : intersectModes) {
@@ -6395,6 +7460,11 @@ namespace embree
           }
         }
       }
+      for (auto sflags : sceneFlagsDynamic)
+        groups.top()->add(new UpdateRangeTest("range."+to_string(sflags),isa,sflags));
+      groups.top()->add(new UpdateRangeSubdivTest("range.subdiv.smooth_boundary",isa,RTC_SUBDIVISION_MODE_SMOOTH_BOUNDARY));
+      groups.top()->add(new UpdateRangeSubdivTest("range.subdiv.pin_corners",isa,RTC_SUBDIVISION_MODE_PIN_CORNERS));
+      groups.top()->add(new UpdateRangeSubdivTest("range.subdiv.pin_boundary",isa,RTC_SUBDIVISION_MODE_PIN_BOUNDARY));
       groups.pop();
 
 #if !defined(TASKING_PPL) // FIXME: PPL has some issues here!
@@ -6447,6 +7517,11 @@ namespace embree
       groups.pop();
 
       groups.pop();
+
+      push(new TestGroup("tessellation_cache",true,false));
+      groups.top()->add(new TessellationCacheTest("segmented",isa,RTC_TESSELLATION_CACHE_MODE_SEGMENTED));
+      groups.top()->add(new TessellationCacheTest("lru",isa,RTC_TESSELLATION_CACHE_MODE_LRU));
+      groups.pop();
       
       /**************************************************************************/
       /*                      Intersection Tests                                */
@@ -6696,6 +7771,7 @@ namespace embree
 
       groups.top()->add(new MemoryMonitorTest("regression_static_memory_monitor", isa,rtcore_regression_static_thread,30));
       groups.top()->add(new MemoryMonitorTest("regression_dynamic_memory_monitor",isa,rtcore_regression_dynamic_thread,30));
+      groups.top()->add(new MemoryMonitorTest("regression_static_memory_monitor_arena",isa,rtcore_regression_static_thread,30,",alloc_arena=1"));
 
       groups.top()->add(new ParallelForExceptionTest1("parallel_for_exception_test1",isa));
       groups.top()->add(new ParallelForExceptionTest2("parallel_for_exception_test2",isa));
@@ -6736,6 +7812,8 @@ namespace embree
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT8,VARIANT_OCCLUDED));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT16,VARIANT_INTERSECT));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT16,VARIANT_OCCLUDED));
+      benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_INTERSECT));
+      benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_OCCLUDED));
 
       GeometryType benchmark_gtypes[] = { 
         TRIANGLE_MESH, 
@@ -6754,6 +7832,10 @@ namespace embree
       };
 
       groups.top()->add(new SimpleBenchmark("simple",isa));
+      groups.top()->add(new TaskingBenchmark("tasking.flat",isa,1024*1024,1));
+      groups.top()->add(new TaskingBenchmark("tasking.nested",isa,1024,1024));
+      groups.top()->add(new BinningBenchmark("binning.100k",isa,158));
+      groups.top()->add(new BinningBenchmark("binning.1M",isa,500));
       
       for (auto gtype : benchmark_gtypes)
         for (auto& sflags : benchmark_sflags_quality) 